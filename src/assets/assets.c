@@ -1,5 +1,6 @@
 #include "assets.h"
 
+#include "assets/cache.h"
 #include "assets/group.h"
 #include "assets/image.h"
 #include "assets/xml.h"
@@ -7,6 +8,7 @@
 #include "core/log.h"
 #include "graphics/renderer.h"
 #include "core/png_read.h"
+#include "game/system.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -17,15 +19,8 @@ static struct {
     int asset_lookup[ASSET_MAX_KEY];
 } data;
 
-void assets_init(int force_reload, color_t **main_images, int *main_image_widths)
+static void load_from_files(uint64_t cache_key, color_t **main_images, int *main_image_widths)
 {
-    if (graphics_renderer()->has_image_atlas(ATLAS_EXTRA_ASSET) && !force_reload) {
-        asset_image_reload_climate();
-        return;
-    }
-
-    graphics_renderer()->free_image_atlas(ATLAS_EXTRA_ASSET);
-
     const dir_listing *xml_files = dir_find_files_with_extension(ASSETS_DIRECTORY "/" ASSETS_IMAGE_PATH, "xml");
 
     if (!group_create_all(xml_files->num_files) || !asset_image_init_array()) {
@@ -40,7 +35,30 @@ void assets_init(int force_reload, color_t **main_images, int *main_image_widths
 
     xml_finish();
 
-    asset_image_load_all(main_images, main_image_widths);
+    const image_atlas_data *atlas_data = asset_image_pack_all(main_images, main_image_widths);
+    if (atlas_data) {
+        assets_cache_save(cache_key, atlas_data);
+        graphics_renderer()->create_image_atlas(atlas_data, 1);
+    }
+}
+
+void assets_init(int force_reload, const char *main_images_file, color_t **main_images, int *main_image_widths)
+{
+    if (graphics_renderer()->has_image_atlas(ATLAS_EXTRA_ASSET) && !force_reload) {
+        asset_image_reload_climate();
+        return;
+    }
+
+    graphics_renderer()->free_image_atlas(ATLAS_EXTRA_ASSET);
+
+    uint64_t start_time = system_get_ticks();
+    uint64_t cache_key = assets_cache_get_key(main_images_file);
+    if (assets_cache_load(cache_key)) {
+        log_info("Extra assets loaded from cache, time in ms:", 0, (int) (system_get_ticks() - start_time));
+    } else {
+        load_from_files(cache_key, main_images, main_image_widths);
+        log_info("Extra assets loaded from files, time in ms:", 0, (int) (system_get_ticks() - start_time));
+    }
 
     group_set_for_external_files();
 
@@ -24,7 +24,7 @@ typedef enum {
 	ASSET_MAX_KEY
 } asset_id;
 
-void assets_init(int force_reload, color_t **main_images, int *main_image_widths);
+void assets_init(int force_reload, const char *main_images_file, color_t **main_images, int *main_image_widths);
 
 int assets_load_single_group(const char *file_name, color_t **main_images, int *main_image_widths);
 
@@ -0,0 +1,491 @@
+#include "cache.h"
+
+#include "assets/assets.h"
+#include "assets/group.h"
+#include "assets/image.h"
+#include "core/dir.h"
+#include "core/file.h"
+#include "core/image.h"
+#include "core/log.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CACHE_FILENAME "assets.cache"
+#define CACHE_MAGIC "AUGASSET"
+#define CACHE_VERSION 1
+
+#define MAX_CACHED_GROUPS 10000
+#define MAX_CACHED_IMAGES 1000000
+#define MAX_CACHED_ATLAS_PAGES 256
+#define MAX_STRING_LENGTH 1024
+
+#define FNV_OFFSET_BASIS 14695981039346656037ull
+#define FNV_PRIME 1099511628211ull
+
+// The cache is written in native byte order: it is only meant to be read back by the same build
+static struct {
+    FILE *fp;
+    int failed;
+} data;
+
+static uint64_t hash_bytes(uint64_t hash, const void *bytes, size_t size)
+{
+    const uint8_t *b = bytes;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= b[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static uint64_t hash_int(uint64_t hash, int value)
+{
+    int32_t v = value;
+    return hash_bytes(hash, &v, sizeof(v));
+}
+
+static uint64_t hash_string(uint64_t hash, const char *str)
+{
+    return hash_bytes(hash, str, strlen(str) + 1);
+}
+
+static uint64_t hash_listing(uint64_t hash, const dir_listing *listing)
+{
+    hash = hash_int(hash, listing->num_files);
+    for (int i = 0; i < listing->num_files; i++) {
+        hash = hash_string(hash, listing->files[i].name);
+        hash = hash_bytes(hash, &listing->files[i].modified_time, sizeof(listing->files[i].modified_time));
+    }
+    return hash;
+}
+
+static uint64_t hash_asset_image_files(uint64_t hash)
+{
+    const dir_listing *subdirs = dir_find_all_subdirectories(ASSETS_DIRECTORY "/" ASSETS_IMAGE_PATH);
+    int num_subdirs = subdirs->num_files;
+    // The listing is reused by every directory search, so the subdirectory names need to be kept apart
+    char *names = malloc(sizeof(char) * FILE_NAME_MAX * (num_subdirs ? num_subdirs : 1));
+    if (!names) {
+        // Never matches a cache that was written with the actual file list
+        return hash_int(hash, -1);
+    }
+    for (int i = 0; i < num_subdirs; i++) {
+        snprintf(&names[i * FILE_NAME_MAX], FILE_NAME_MAX, "%s", subdirs->files[i].name);
+    }
+    hash = hash_int(hash, num_subdirs);
+    for (int i = 0; i < num_subdirs; i++) {
+        char path[FILE_NAME_MAX];
+        snprintf(path, FILE_NAME_MAX, "%s/%s/%s", ASSETS_DIRECTORY, ASSETS_IMAGE_PATH, &names[i * FILE_NAME_MAX]);
+        hash = hash_string(hash, &names[i * FILE_NAME_MAX]);
+        hash = hash_listing(hash, dir_find_files_with_extension(path, "png"));
+    }
+    free(names);
+    return hash_listing(hash, dir_find_files_with_extension(ASSETS_DIRECTORY "/" ASSETS_IMAGE_PATH, "xml"));
+}
+
+uint64_t assets_cache_get_key(const char *main_images_file)
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+    hash = hash_int(hash, CACHE_VERSION);
+
+    // Decides which images are packed and the size of the atlas pages
+    int max_width, max_height;
+    graphics_renderer()->get_max_image_size(&max_width, &max_height);
+    hash = hash_int(hash, max_width);
+    hash = hash_int(hash, max_height);
+
+    // Layers can be copied from the main images, so the climate that was loaded matters as well
+    const char *main_images_path = main_images_file ? dir_get_file(main_images_file, MAY_BE_LOCALIZED) : 0;
+    hash = hash_string(hash, main_images_path ? main_images_path : "");
+
+    return hash_asset_image_files(hash);
+}
+
+static void write_raw(const void *value, size_t size)
+{
+    if (!data.failed && size && fwrite(value, size, 1, data.fp) != 1) {
+        data.failed = 1;
+    }
+}
+
+static void write_i32(int value)
+{
+    int32_t v = value;
+    write_raw(&v, sizeof(v));
+}
+
+static void write_string(const char *str)
+{
+    if (!str) {
+        write_i32(0);
+        return;
+    }
+    int length = (int) strlen(str) + 1;
+    write_i32(length);
+    write_raw(str, length);
+}
+
+static int read_raw(void *value, size_t size)
+{
+    if (!data.failed && size && fread(value, size, 1, data.fp) != 1) {
+        data.failed = 1;
+    }
+    return !data.failed;
+}
+
+static int read_i32(void)
+{
+    int32_t v = 0;
+    read_raw(&v, sizeof(v));
+    return data.failed ? 0 : v;
+}
+
+static char *read_string(void)
+{
+    int length = read_i32();
+    if (length <= 0 || length > MAX_STRING_LENGTH) {
+        if (length) {
+            data.failed = 1;
+        }
+        return 0;
+    }
+    char *str = malloc(sizeof(char) * length);
+    if (!str) {
+        data.failed = 1;
+        return 0;
+    }
+    if (!read_raw(str, length)) {
+        free(str);
+        return 0;
+    }
+    str[length - 1] = 0;
+    return str;
+}
+
+static void write_header(uint64_t key)
+{
+    write_raw(CACHE_MAGIC, sizeof(CACHE_MAGIC) - 1);
+    write_i32(CACHE_VERSION);
+    write_raw(&key, sizeof(key));
+}
+
+static int read_header(uint64_t key)
+{
+    char magic[sizeof(CACHE_MAGIC) - 1];
+    uint64_t cached_key = 0;
+    read_raw(magic, sizeof(magic));
+    int version = read_i32();
+    read_raw(&cached_key, sizeof(cached_key));
+    return !data.failed && memcmp(magic, CACHE_MAGIC, sizeof(magic)) == 0 &&
+        version == CACHE_VERSION && cached_key == key;
+}
+
+static void write_image(const image *img)
+{
+    write_i32(img->x_offset);
+    write_i32(img->y_offset);
+    write_i32(img->width);
+    write_i32(img->height);
+    write_i32(img->original.width);
+    write_i32(img->original.height);
+    write_i32(img->is_isometric);
+    write_i32(img->atlas.id);
+    write_i32(img->atlas.x_offset);
+    write_i32(img->atlas.y_offset);
+}
+
+static void read_image(image *img)
+{
+    img->x_offset = read_i32();
+    img->y_offset = read_i32();
+    img->width = read_i32();
+    img->height = read_i32();
+    img->original.width = read_i32();
+    img->original.height = read_i32();
+    img->is_isometric = read_i32();
+    img->atlas.id = read_i32();
+    img->atlas.x_offset = read_i32();
+    img->atlas.y_offset = read_i32();
+}
+
+static int get_unpacked_data_size(const asset_image *img)
+{
+    // Isometric images with a top keep the top above the footprint, see split_top_and_footprint
+    int height = img->img.height + (img->img.top ? img->img.top->height : 0);
+    return img->img.width * height;
+}
+
+static void write_groups(void)
+{
+    int total = group_get_total();
+    write_i32(total);
+    for (int i = 0; i < total; i++) {
+        const image_groups *group = group_get_from_id(i);
+        write_string(group->name);
+        write_i32(group->first_image_index);
+        write_i32(group->last_image_index);
+    }
+}
+
+static int read_groups(void)
+{
+    int total = read_i32();
+    if (total < 0 || total > MAX_CACHED_GROUPS || !group_create_all(total)) {
+        return 0;
+    }
+    for (int i = 0; i < total; i++) {
+        image_groups *group = group_get_new();
+        group->name = read_string();
+        group->first_image_index = read_i32();
+        group->last_image_index = read_i32();
+        if (!group->name) {
+            return 0;
+        }
+    }
+    return !data.failed;
+}
+
+static int get_total_images(void)
+{
+    int total = 1;
+    while (asset_image_get_from_id(total)) {
+        total++;
+    }
+    return total;
+}
+
+static void write_asset_image(const asset_image *img)
+{
+    write_i32(img->active);
+    if (!img->active) {
+        return;
+    }
+    write_string(img->id);
+    write_i32(img->is_reference);
+    write_image(&img->img);
+    if (!img->is_reference) {
+        // References share the top of the image they reference, which is linked again when loading
+        write_i32(img->img.top != 0);
+        if (img->img.top) {
+            write_image(img->img.top);
+        }
+    }
+    write_i32(img->img.animation != 0);
+    if (img->img.animation) {
+        write_raw(img->img.animation, sizeof(image_animation));
+    }
+    if (img->is_reference) {
+        const layer *l = &img->first_layer;
+        write_i32(l->calculated_image_id);
+        write_i32(l->x_offset);
+        write_i32(l->y_offset);
+        write_i32(l->width);
+        write_i32(l->height);
+    }
+    int num_pixels = img->data ? get_unpacked_data_size(img) : 0;
+    write_i32(num_pixels);
+    write_raw(img->data, sizeof(color_t) * num_pixels);
+}
+
+static void write_images(void)
+{
+    int total = get_total_images();
+    write_i32(total);
+    for (int i = 1; i < total; i++) {
+        write_asset_image(asset_image_get_from_id(i));
+    }
+}
+
+static int read_asset_image(asset_image *img)
+{
+    img->last_layer = &img->first_layer;
+    if (!read_i32()) {
+        asset_image_unload(img);
+        return !data.failed;
+    }
+    img->id = read_string();
+    img->is_reference = read_i32();
+    read_image(&img->img);
+    if (!img->is_reference && read_i32()) {
+        img->img.top = malloc(sizeof(image));
+        if (!img->img.top) {
+            return 0;
+        }
+        memset(img->img.top, 0, sizeof(image));
+        read_image(img->img.top);
+    }
+    if (read_i32()) {
+        img->img.animation = malloc(sizeof(image_animation));
+        if (!img->img.animation || !read_raw(img->img.animation, sizeof(image_animation))) {
+            return 0;
+        }
+    }
+    if (img->is_reference) {
+        layer *l = &img->first_layer;
+        l->calculated_image_id = read_i32();
+        l->x_offset = read_i32();
+        l->y_offset = read_i32();
+        l->width = read_i32();
+        l->height = read_i32();
+    }
+    int num_pixels = read_i32();
+    if (data.failed || (num_pixels && num_pixels != get_unpacked_data_size(img))) {
+        return 0;
+    }
+    if (num_pixels) {
+        color_t *pixels = malloc(sizeof(color_t) * num_pixels);
+        if (!pixels) {
+            return 0;
+        }
+        img->data = pixels;
+        return read_raw(pixels, sizeof(color_t) * num_pixels);
+    }
+    return 1;
+}
+
+static int link_reference(asset_image *img)
+{
+    int image_id = img->first_layer.calculated_image_id;
+    if (image_id >= IMAGE_MAIN_ENTRIES) {
+        const asset_image *referenced = asset_image_get_from_id(image_id - IMAGE_MAIN_ENTRIES);
+        if (!referenced || !referenced->active || referenced->is_reference) {
+            return 0;
+        }
+        img->img.top = referenced->img.top;
+    } else {
+        // The cache is only valid for the main images it was created with, so the position is still correct
+        img->img.top = image_get(image_id)->top;
+    }
+    return 1;
+}
+
+static int read_images(void)
+{
+    int total = read_i32();
+    if (total <= 0 || total > MAX_CACHED_IMAGES || !asset_image_init_array()) {
+        return 0;
+    }
+    // Create every image first, so that unused ones don't get reused by the next image
+    for (int i = 1; i < total; i++) {
+        asset_image *img = asset_image_create();
+        if (!img || img->index != i) {
+            return 0;
+        }
+    }
+    for (int i = 1; i < total; i++) {
+        if (!read_asset_image(asset_image_get_from_id(i))) {
+            return 0;
+        }
+    }
+    for (int i = 1; i < total; i++) {
+        asset_image *img = asset_image_get_from_id(i);
+        if (img->active && img->is_reference && !link_reference(img)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void write_atlas(const image_atlas_data *atlas_data)
+{
+    write_i32(atlas_data->num_images);
+    for (int i = 0; i < atlas_data->num_images; i++) {
+        write_i32(atlas_data->image_widths[i]);
+        write_i32(atlas_data->image_heights[i]);
+    }
+    for (int i = 0; i < atlas_data->num_images; i++) {
+        write_raw(atlas_data->buffers[i], sizeof(color_t) * atlas_data->image_widths[i] * atlas_data->image_heights[i]);
+    }
+}
+
+static int read_atlas(void)
+{
+    int num_images = read_i32();
+    if (num_images <= 0 || num_images > MAX_CACHED_ATLAS_PAGES) {
+        return 0;
+    }
+    int widths[MAX_CACHED_ATLAS_PAGES];
+    int heights[MAX_CACHED_ATLAS_PAGES];
+    for (int i = 0; i < num_images; i++) {
+        widths[i] = read_i32();
+        heights[i] = read_i32();
+    }
+    if (data.failed) {
+        return 0;
+    }
+    const image_atlas_data *atlas_data = graphics_renderer()->prepare_image_atlas(ATLAS_EXTRA_ASSET,
+        num_images, widths[num_images - 1], heights[num_images - 1]);
+    if (!atlas_data) {
+        return 0;
+    }
+    for (int i = 0; i < num_images; i++) {
+        if (atlas_data->image_widths[i] != widths[i] || atlas_data->image_heights[i] != heights[i] ||
+            !read_raw(atlas_data->buffers[i], sizeof(color_t) * widths[i] * heights[i])) {
+            return 0;
+        }
+    }
+    return graphics_renderer()->create_image_atlas(atlas_data, 1);
+}
+
+int assets_cache_load(uint64_t key)
+{
+    const char *filename = dir_get_file_at_location(CACHE_FILENAME, PATH_LOCATION_CONFIG);
+    if (!filename) {
+        return 0;
+    }
+    data.fp = file_open(filename, "rb");
+    if (!data.fp) {
+        return 0;
+    }
+    data.failed = 0;
+    if (!read_header(key)) {
+        file_close(data.fp);
+        data.fp = 0;
+        log_info("Extra assets have changed, rebuilding the cache", 0, 0);
+        return 0;
+    }
+    int loaded = read_groups() && read_images() && read_atlas();
+    file_close(data.fp);
+    data.fp = 0;
+    if (!loaded) {
+        log_error("Extra assets cache is invalid, rebuilding it", 0, 0);
+        graphics_renderer()->free_image_atlas(ATLAS_EXTRA_ASSET);
+        return 0;
+    }
+    return 1;
+}
+
+void assets_cache_save(uint64_t key, const image_atlas_data *atlas_data)
+{
+    char filename[FILE_NAME_MAX];
+    snprintf(filename, FILE_NAME_MAX, "%s", dir_append_location(CACHE_FILENAME, PATH_LOCATION_CONFIG));
+    data.fp = file_open(filename, "wb");
+    if (!data.fp) {
+        log_error("Unable to write extra assets cache", filename, 0);
+        return;
+    }
+    data.failed = 0;
+
+    // The real key is only written at the end, so a partially written cache never matches
+    write_header(0);
+    write_groups();
+    write_images();
+    write_atlas(atlas_data);
+    if (!data.failed) {
+        if (fseek(data.fp, 0, SEEK_SET) == 0) {
+            write_header(key);
+        } else {
+            data.failed = 1;
+        }
+    }
+    if (file_close(data.fp) != 0) {
+        data.failed = 1;
+    }
+    data.fp = 0;
+    if (data.failed) {
+        log_error("Unable to write extra assets cache", filename, 0);
+        file_remove(filename);
+    }
+}
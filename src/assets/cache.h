@@ -0,0 +1,13 @@
+#ifndef ASSETS_CACHE_H
+#define ASSETS_CACHE_H
+
+#include "graphics/renderer.h"
+
+#include <stdint.h>
+
+uint64_t assets_cache_get_key(const char *main_images_file);
+
+int assets_cache_load(uint64_t key);
+void assets_cache_save(uint64_t key, const image_atlas_data *atlas_data);
+
+#endif // ASSETS_CACHE_H
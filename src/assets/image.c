@@ -493,9 +493,9 @@ asset_image *asset_image_create(void)
     return result;
 }
 
-int asset_image_load_all(color_t **main_images, int *main_image_widths)
-{
 #ifndef BUILDING_ASSET_PACKER
+const image_atlas_data *asset_image_pack_all(color_t **main_images, int *main_image_widths)
+{
     image_packer packer;
     int max_width, max_height;
     graphics_renderer()->get_max_image_size(&max_width, &max_height);
@@ -563,6 +563,7 @@ int asset_image_load_all(color_t **main_images, int *main_image_widths)
         packer.result.images_needed, packer.result.last_image_width, packer.result.last_image_height);
     if (!atlas_data) {
         log_error("Failed to create packed images atlas - out of memory", 0, 0);
+        image_packer_free(&packer);
         return 0;
     }
 
@@ -635,6 +636,17 @@ int asset_image_load_all(color_t **main_images, int *main_image_widths)
         }
     }
     image_packer_free(&packer);
+    return atlas_data;
+}
+#endif
+
+int asset_image_load_all(color_t **main_images, int *main_image_widths)
+{
+#ifndef BUILDING_ASSET_PACKER
+    const image_atlas_data *atlas_data = asset_image_pack_all(main_images, main_image_widths);
+    if (!atlas_data) {
+        return 0;
+    }
     graphics_renderer()->create_image_atlas(atlas_data, 1);
 #endif
     return 1;
@@ -31,6 +31,7 @@ asset_image *asset_image_get_from_id(int image_id);
 
 int asset_image_init_array(void);
 asset_image *asset_image_create(void);
+const image_atlas_data *asset_image_pack_all(color_t **main_images, int *main_image_widths);
 int asset_image_load_all(color_t **main_images, int *main_image_widths);
 void asset_image_reload_climate(void);
 void asset_image_count_isometric(void);
@@ -1,5 +1,6 @@
 #include "building.h"
 
+#include "building/count.h"
 #include "building/distribution.h"
 #include "building/industry.h"
 #include "building/granary.h"
@@ -186,7 +187,7 @@ building *building_create(building_type type, int x, int y)
 
     const building_properties *props = building_properties_for_type(type);
 
-    b->state = BUILDING_STATE_CREATED;
+    building_set_state(b, BUILDING_STATE_CREATED);
     b->faction_id = 1;
     b->type = type;
     b->size = props->size;
@@ -256,6 +257,16 @@ void building_change_type(building *b, building_type type)
     remove_adjacent_types(b);
     b->type = type;
     fill_adjacent_types(b);
+    building_count_invalidate();
+}
+
+void building_set_state(building *b, int state)
+{
+    if (b->state == state) {
+        return;
+    }
+    b->state = state;
+    building_count_invalidate();
 }
 
 static void building_delete(building *b)
@@ -267,6 +278,7 @@ static void building_delete(building *b)
     b->id = id;
 
     array_trim(data.buildings);
+    building_count_invalidate();
 }
 
 void building_clear_related_data(building *b)
@@ -295,6 +307,7 @@ building *building_restore_from_undo(building *to_restore)
         data.buildings.size = b->id + 1;
     }
     fill_adjacent_types(b);
+    building_count_invalidate();
     return b;
 }
 
@@ -312,7 +325,7 @@ void building_update_state(void)
     building *b;
     array_foreach(data.buildings, b) {
         if (b->state == BUILDING_STATE_CREATED) {
-            b->state = BUILDING_STATE_IN_USE;
+            building_set_state(b, BUILDING_STATE_IN_USE);
         }
         if (b->state == BUILDING_STATE_IN_USE && b->house_size) {
             continue;
@@ -492,10 +505,10 @@ int building_is_fort(building_type type)
 int building_mothball_toggle(building *b)
 {
     if (b->state == BUILDING_STATE_IN_USE) {
-        b->state = BUILDING_STATE_MOTHBALLED;
+        building_set_state(b, BUILDING_STATE_MOTHBALLED);
         b->num_workers = 0;
     } else if (b->state == BUILDING_STATE_MOTHBALLED) {
-        b->state = BUILDING_STATE_IN_USE;
+        building_set_state(b, BUILDING_STATE_IN_USE);
     }
     return b->state;
 }
@@ -504,11 +517,11 @@ int building_mothball_set(building *b, int mothball)
 {
     if (mothball) {
         if (b->state == BUILDING_STATE_IN_USE) {
-            b->state = BUILDING_STATE_MOTHBALLED;
+            building_set_state(b, BUILDING_STATE_MOTHBALLED);
             b->num_workers = 0;
         }
     } else if (b->state == BUILDING_STATE_MOTHBALLED) {
-        b->state = BUILDING_STATE_IN_USE;
+        building_set_state(b, BUILDING_STATE_IN_USE);
     }
     return b->state;
 
@@ -610,6 +623,8 @@ void building_clear_all(void)
     extra.created_sequence = 0;
     extra.incorrect_houses = 0;
     extra.unfixable_houses = 0;
+
+    building_count_invalidate();
 }
 
 void building_make_immune_cheat(void)
@@ -683,6 +698,7 @@ void building_load_state(buffer *buf, buffer *sequence, buffer *corrupt_houses,
     }
 
     data.buildings.size = highest_id_in_use + 1;
+    building_count_invalidate();
 
     extra.created_sequence = buffer_read_i32(sequence);
 
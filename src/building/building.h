@@ -216,6 +216,8 @@ building *building_first_of_type(building_type type);
 
 void building_change_type(building *b, building_type type);
 
+void building_set_state(building *b, int state);
+
 building *building_main(building *b);
 
 building *building_next(building *b);
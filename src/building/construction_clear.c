@@ -124,7 +124,7 @@ static int clear_land_confirmed(int measure_only, int x_start, int y_start, int
                     items_placed++;
                     game_undo_add_building(b);
                 }
-                b->state = BUILDING_STATE_DELETED_BY_PLAYER;
+                building_set_state(b, BUILDING_STATE_DELETED_BY_PLAYER);
                 b->is_deleted = 1;
                 building *space = b;
                 for (int i = 0; i < 9; i++) {
@@ -133,7 +133,7 @@ static int clear_land_confirmed(int measure_only, int x_start, int y_start, int
                     }
                     space = building_get(space->prev_part_building_id);
                     game_undo_add_building(space);
-                    space->state = BUILDING_STATE_DELETED_BY_PLAYER;
+                    building_set_state(space, BUILDING_STATE_DELETED_BY_PLAYER);
                 }
                 space = b;
                 for (int i = 0; i < 9; i++) {
@@ -142,7 +142,7 @@ static int clear_land_confirmed(int measure_only, int x_start, int y_start, int
                         break;
                     }
                     game_undo_add_building(space);
-                    space->state = BUILDING_STATE_DELETED_BY_PLAYER;
+                    building_set_state(space, BUILDING_STATE_DELETED_BY_PLAYER);
                 }
             } else if (map_terrain_is(grid_offset, TERRAIN_AQUEDUCT)) {
                 map_terrain_remove(grid_offset, TERRAIN_CLEARABLE & ~TERRAIN_HIGHWAY);
@@ -9,6 +9,9 @@
 #include "map/building.h"
 #include "map/grid.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 static const building_type building_set_farms[] = {
     BUILDING_WHEAT_FARM, BUILDING_VEGETABLE_FARM, BUILDING_FRUIT_FARM, BUILDING_OLIVE_FARM,
     BUILDING_VINES_FARM, BUILDING_PIG_FARM
@@ -74,6 +77,49 @@ static const building_type building_set_deco_statues[] = {
 
 #define BUILDING_SET_SIZE_DECO_STATUES (sizeof(building_set_deco_statues) / sizeof(building_type))
 
+typedef struct {
+    const building_type *types;
+    int count;
+} building_set;
+
+static struct {
+    int totals_valid;
+    int total[BUILDING_TYPE_MAX];
+    int any_total;
+    struct {
+        unsigned int *counted_in_query;
+        int size;
+        unsigned int query;
+    } area;
+} data;
+
+void building_count_invalidate(void)
+{
+    data.totals_valid = 0;
+}
+
+static int is_counted_in_total(building *b)
+{
+    return (b->state == BUILDING_STATE_IN_USE || b->state == BUILDING_STATE_CREATED) && b == building_main(b);
+}
+
+static void update_totals(void)
+{
+    if (data.totals_valid) {
+        return;
+    }
+    memset(data.total, 0, sizeof(data.total));
+    data.any_total = 0;
+    for (int id = 1; id < building_count(); id++) {
+        building *b = building_get(id);
+        if (is_counted_in_total(b)) {
+            data.total[b->type]++;
+            data.any_total++;
+        }
+    }
+    data.totals_valid = 1;
+}
+
 int building_count_grand_temples(void)
 {
     return building_count_total(BUILDING_GRAND_TEMPLE_CERES) +
@@ -107,30 +153,24 @@ int building_count_active(building_type type)
 
 int building_count_total(building_type type)
 {
-    int total = 0;
-    for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-        if ((b->state == BUILDING_STATE_IN_USE || b->state == BUILDING_STATE_CREATED) && b == building_main(b)) {
-            total++;
-        }
+    if (type < 0 || type >= BUILDING_TYPE_MAX) {
+        return 0;
     }
-    return total;
+    update_totals();
+    return data.total[type];
 }
 
 int building_count_any_total(int active_only)
 {
+    if (!active_only) {
+        update_totals();
+        return data.any_total;
+    }
     int total = 0;
     for (int id = 1; id < building_count(); id++) {
         building *b = building_get(id);
-        if (b == building_main(b)) {
-            if (active_only) {
-                if (building_is_active(b)) {
-                    total++;
-                }
-            } else {
-                if (b->state == BUILDING_STATE_IN_USE || b->state == BUILDING_STATE_CREATED) {
-                    total++;
-                }
-            }
+        if (b == building_main(b) && building_is_active(b)) {
+            total++;
         }
     }
     return total;
@@ -147,13 +187,33 @@ int building_count_upgraded(building_type type)
     return upgraded;
 }
 
-int building_count_in_area(building_type type, int minx, int miny, int maxx, int maxy)
+static int start_area_query(void)
 {
-    int grid_area = (abs(maxx - minx) + 1) * (abs(maxy - miny) + 1);
-    int array_size = grid_area < building_count() ? grid_area : building_count();
-    unsigned int *found_buildings = (unsigned int *) malloc(array_size * sizeof(unsigned int));
-    memset(found_buildings, 0, array_size * sizeof(unsigned int));
+    int size = building_count();
+    if (size > data.area.size) {
+        unsigned int *counted = realloc(data.area.counted_in_query, size * sizeof(unsigned int));
+        if (!counted) {
+            return 0;
+        }
+        memset(counted + data.area.size, 0, (size - data.area.size) * sizeof(unsigned int));
+        data.area.counted_in_query = counted;
+        data.area.size = size;
+    }
+    data.area.query++;
+    if (!data.area.query) {
+        memset(data.area.counted_in_query, 0, data.area.size * sizeof(unsigned int));
+        data.area.query = 1;
+    }
+    return 1;
+}
 
+// Buildings are counted once, no matter how many of their tiles are in the area
+static int count_in_area(int minx, int miny, int maxx, int maxy,
+    int (*matches)(const building *b, const void *filter), const void *filter)
+{
+    if (!start_area_query()) {
+        return 0;
+    }
     int total = 0;
     for (int x = minx; x <= maxx; x++) {
         for (int y = miny; y <= maxy; y++) {
@@ -161,77 +221,54 @@ int building_count_in_area(building_type type, int minx, int miny, int maxx, int
             int building_id = map_building_at(grid_offset);
             if (building_id) {
                 building *b = building_main(building_get(building_id));
-                if (type != BUILDING_ANY && b->type != type) {
+                if (!matches(b, filter)) {
                     continue;
                 }
                 if (b->state != BUILDING_STATE_IN_USE && b->state != BUILDING_STATE_CREATED) {
                     continue;
                 }
-
-                int building_already_counted = 0;
-
-                for (int i = 0; i < total; i++) {
-                    if (found_buildings[i] == b->id) {
-                        building_already_counted = 1;
-                        break;
-                    }
-                }
-
-                if (building_already_counted) {
+                if (b->id >= data.area.size || data.area.counted_in_query[b->id] == data.area.query) {
                     continue;
                 }
-
-                found_buildings[total] = b->id;
+                data.area.counted_in_query[b->id] = data.area.query;
                 total++;
             }
         }
     }
-
-    free(found_buildings);
     return total;
 }
 
-int building_count_fort_type_in_area(int minx, int miny, int maxx, int maxy, figure_type type)
+static int building_matches_type(const building *b, const void *filter)
 {
-    int grid_area = abs((maxx - minx) * (maxy - miny));
-    int array_size = grid_area < building_count() ? grid_area : building_count();
-    int *found_buildings = (int *) malloc(array_size * sizeof(int));
-
-    int total = 0;
-    for (int x = minx; x <= maxx; x++) {
-        for (int y = miny; y <= maxy; y++) {
-            int grid_offset = map_grid_offset(x, y);
-            int building_id = map_building_at(grid_offset);
-            if (building_id) {
-                building *b = building_main(building_get(building_id));
-                if (b->type != BUILDING_FORT || b->subtype.fort_figure_type != type) {
-                    continue;
-                }
-                if (b->state != BUILDING_STATE_IN_USE && b->state != BUILDING_STATE_CREATED) {
-                    continue;
-                }
-
-                int building_already_counted = 0;
-
-                for (int i = 0; i < total; i++) {
-                    if (found_buildings[i] == b->id) {
-                        building_already_counted = 1;
-                        break;
-                    }
-                }
-
-                if (building_already_counted) {
-                    continue;
-                }
+    building_type type = *(const building_type *) filter;
+    return type == BUILDING_ANY || b->type == type;
+}
 
-                found_buildings[total] = b->id;
-                total++;
-            }
+static int building_matches_set(const building *b, const void *filter)
+{
+    const building_set *set = filter;
+    for (int i = 0; i < set->count; i++) {
+        if (b->type == set->types[i]) {
+            return 1;
         }
     }
+    return 0;
+}
 
-    free(found_buildings);
-    return total;
+static int building_matches_fort_type(const building *b, const void *filter)
+{
+    figure_type type = *(const figure_type *) filter;
+    return b->type == BUILDING_FORT && b->subtype.fort_figure_type == type;
+}
+
+int building_count_in_area(building_type type, int minx, int miny, int maxx, int maxy)
+{
+    return count_in_area(minx, miny, maxx, maxy, building_matches_type, &type);
+}
+
+int building_count_fort_type_in_area(int minx, int miny, int maxx, int maxy, figure_type type)
+{
+    return count_in_area(minx, miny, maxx, maxy, building_matches_fort_type, &type);
 }
 
 static int building_count_with_active_check(building_type type, int active_only)
@@ -255,12 +292,8 @@ static int count_all_types_in_set(int active_only, const building_type *set, int
 
 static int count_all_types_in_set_in_area(const building_type *set, int count, int minx, int miny, int maxx, int maxy)
 {
-    int total = 0;
-    for (int i = 0; i < count; i++) {
-        building_type type = set[i];
-        total += building_count_in_area(type, minx, miny, maxx, maxy);
-    }
-    return total;
+    building_set filter = { set, count };
+    return count_in_area(minx, miny, maxx, maxy, building_matches_set, &filter);
 }
 
 int building_set_count_farms(int active_only)
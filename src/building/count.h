@@ -11,6 +11,12 @@
  * Building totals
  */
 
+/**
+ * Marks the building totals as outdated, they are recounted on the next request.
+ * Called whenever a building is created, removed or changes its type or state.
+ */
+void building_count_invalidate(void);
+
 /**
  * Returns the active building count for the type
  * @param type Building type
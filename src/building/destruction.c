@@ -52,7 +52,7 @@ static void destroy_on_fire(building *b, int plagued)
     }
     map_building_tiles_remove(b->id, b->x, b->y);
     if (map_terrain_is(b->grid_offset, TERRAIN_WATER)) {
-        b->state = BUILDING_STATE_DELETED_BY_GAME;
+        building_set_state(b, BUILDING_STATE_DELETED_BY_GAME);
     } else {
         building_change_type(b, BUILDING_BURNING_RUIN);
         b->figure_id4 = 0;
@@ -103,7 +103,7 @@ static void destroy_linked_parts(building *b, int on_fire, int plagued)
             destroy_on_fire(part, plagued);
         } else {
             map_building_tiles_set_rubble(part_id, part->x, part->y, part->size);
-            part->state = BUILDING_STATE_RUBBLE;
+            building_set_state(part, BUILDING_STATE_RUBBLE);
         }
     }
 
@@ -118,7 +118,7 @@ static void destroy_linked_parts(building *b, int on_fire, int plagued)
             destroy_on_fire(part, plagued);
         } else {
             map_building_tiles_set_rubble(part->id, part->x, part->y, part->size);
-            part->state = BUILDING_STATE_RUBBLE;
+            building_set_state(part, BUILDING_STATE_RUBBLE);
         }
     }
 
@@ -134,7 +134,7 @@ static void destroy_linked_parts(building *b, int on_fire, int plagued)
 
 void building_destroy_by_collapse(building *b)
 {
-    b->state = BUILDING_STATE_RUBBLE;
+    building_set_state(b, BUILDING_STATE_RUBBLE);
     map_building_tiles_set_rubble(b->id, b->x, b->y, b->size);
     figure_create_explosion_cloud(b->x, b->y, b->size);
     destroy_linked_parts(b, 0, 0);
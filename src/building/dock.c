@@ -78,7 +78,7 @@ int building_dock_accepts_ship(int ship_id, int dock_id)
 {
     building *dock = building_get(dock_id);
     figure *f = figure_get(ship_id);
-    empire_city *city = empire_city_get(f->empire_city_id);
+    empire_city *city = empire_city_get(figure_extra_get(f->id)->empire_city_id);
     if (!building_dock_can_trade_with_route(city->route_id, dock_id)) {
         return 0;
     }
@@ -95,7 +95,7 @@ int building_dock_accepts_ship(int ship_id, int dock_id)
 int building_dock_can_import_from_ship(const building *dock, int ship_id)
 {
     figure *ship = figure_get(ship_id);
-    if (trader_has_sold_max(ship->trader_id)) {
+    if (trader_has_sold_max(figure_extra_get(ship->id)->trader_id)) {
         return 0;
     }
 
@@ -115,7 +115,7 @@ int building_dock_can_import_from_ship(const building *dock, int ship_id)
 int building_dock_can_export_to_ship(const building *dock, int ship_id)
 {
     figure *ship = figure_get(ship_id);
-    if (trader_has_bought_max(ship->trader_id)) {
+    if (trader_has_bought_max(figure_extra_get(ship->id)->trader_id)) {
         return 0;
     }
 
@@ -173,6 +173,7 @@ static void get_already_handled_goods(handled_goods *handled, int ship_id)
 
 static int all_dock_goods_already_handled(const handled_goods *handled, const building *dock, const figure *ship)
 {
+    figure_extra *ship_extra = figure_extra_get(ship->id);
     for (int i = 0; i < handled->max_networks; i++) {
         const handled_goods_by_road_network *network = &handled->networks[i];
         if (network->road_network_id != dock->road_network_id) {
@@ -180,8 +181,8 @@ static int all_dock_goods_already_handled(const handled_goods *handled, const bu
         }
         // we've visited docks on this road network
         for (int r = RESOURCE_MIN; r < RESOURCE_MAX; r++) {
-            if (!empire_can_import_resource_from_city(ship->empire_city_id, r) &&
-                !empire_can_export_resource_to_city(ship->empire_city_id, r)) {
+            if (!empire_can_import_resource_from_city(ship_extra->empire_city_id, r) &&
+                !empire_can_export_resource_to_city(ship_extra->empire_city_id, r)) {
                 // the ship doesn't buy or sell this good
                 continue;
             }
@@ -241,7 +241,7 @@ void house_population_evict_overcrowded(void)
                 b->house_population -= num_people_to_evict;
             } else {
                 // house has been removed
-                b->state = BUILDING_STATE_UNDO;
+                building_set_state(b, BUILDING_STATE_UNDO);
             }
         }
     }
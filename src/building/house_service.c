@@ -3,6 +3,15 @@
 #include "building/building.h"
 #include "building/monument.h"
 #include "city/culture.h"
+#include "core/jobs.h"
+
+#define MIN_BUILDINGS_PER_JOB_PART 1000
+
+typedef struct {
+    int venus_module2;
+    int completed_colosseum;
+    int completed_hippodrome;
+} culture_bonus;
 
 static void decay(unsigned char *value)
 {
@@ -75,107 +84,119 @@ void house_service_decay_houses_covered(void)
     }
 }
 
-void house_service_calculate_culture_aggregates(void)
+static void calculate_house_aggregates(building *b, const culture_bonus *bonus)
 {
-    int venus_module2 = building_monument_gt_module_is_active(VENUS_MODULE_2_DESIRABILITY_ENTERTAINMENT);
-    int completed_colosseum = building_monument_working(BUILDING_COLOSSEUM);
-    int completed_hippodrome = building_monument_working(BUILDING_HIPPODROME);
+    int arena_total = 0;
+    int colosseum_total = 0;
 
-    for (building_type type = BUILDING_HOUSE_SMALL_TENT; type <= BUILDING_HOUSE_LUXURY_PALACE; type++) {
-        for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-            if (b->state != BUILDING_STATE_IN_USE || !b->house_size) {
-                continue;
-            }
-            int arena_total = 0;
-            int colosseum_total = 0;
+    // Entertainment
+    b->data.house.entertainment = 0;
 
-            // Entertainment
-            b->data.house.entertainment = 0;
+    if (b->data.house.theater) {
+        b->data.house.entertainment += 10;
+    }
 
-            if (b->data.house.theater) {
-                b->data.house.entertainment += 10;
-            }
+    if (b->house_tavern_wine_access) {
+        b->data.house.entertainment += 10;
+        if (b->house_tavern_food_access) {
+            b->data.house.entertainment += 5;
+        }
+    }
 
-            if (b->house_tavern_wine_access) {
-                b->data.house.entertainment += 10;
-                if (b->house_tavern_food_access) {
-                    b->data.house.entertainment += 5;
-                }
-            }
+    if (b->data.house.amphitheater_actor) {
+        if (b->data.house.amphitheater_gladiator) {
+            b->data.house.entertainment += 15;
+        } else {
+            b->data.house.entertainment += 10;
+        }
+    }
 
-            if (b->data.house.amphitheater_actor) {
-                if (b->data.house.amphitheater_gladiator) {
-                    b->data.house.entertainment += 15;
-                } else {
-                    b->data.house.entertainment += 10;
-                }
-            }
+    if (b->house_arena_gladiator) {
+        arena_total = b->house_arena_lion ? 20 : 10;
+    }
 
-            if (b->house_arena_gladiator) {
-                arena_total = b->house_arena_lion ? 20 : 10;
-            }
+    if (b->data.house.colosseum_gladiator) {
+        colosseum_total = b->data.house.colosseum_lion ? 25 : 15;
+    }
 
-            if (b->data.house.colosseum_gladiator) {
-                colosseum_total = b->data.house.colosseum_lion ? 25 : 15;
-            }
+    b->data.house.entertainment += arena_total > colosseum_total ? arena_total : colosseum_total;
 
-            b->data.house.entertainment += arena_total > colosseum_total ? arena_total : colosseum_total;
+    if (b->data.house.hippodrome) {
+        b->data.house.entertainment += 30;
+    }
 
-            if (b->data.house.hippodrome) {
-                b->data.house.entertainment += 30;
-            }
+    if (bonus->completed_hippodrome) {
+        b->data.house.entertainment += 5;
+    }
 
-            if (completed_hippodrome) {
-                b->data.house.entertainment += 5;
-            }
+    if (bonus->completed_colosseum) {
+        b->data.house.entertainment += 5;
+    }
 
-            if (completed_colosseum) {
-                b->data.house.entertainment += 5;
-            }
+    // Venus Module 2 Entertainment Bonus
+    if (bonus->venus_module2 && b->data.house.temple_venus) {
+        b->data.house.entertainment += 10;
+    }
 
-            // Venus Module 2 Entertainment Bonus
-            if (venus_module2 && b->data.house.temple_venus) {
-                b->data.house.entertainment += 10;
+    // Education
+    b->data.house.education = 0;
+    if (b->data.house.school || b->data.house.library) {
+        b->data.house.education = 1;
+        if (b->data.house.school && b->data.house.library) {
+            b->data.house.education = 2;
+            if (b->data.house.academy) {
+                b->data.house.education = 3;
             }
+        }
+    }
 
-            // Education
-            b->data.house.education = 0;
-            if (b->data.house.school || b->data.house.library) {
-                b->data.house.education = 1;
-                if (b->data.house.school && b->data.house.library) {
-                    b->data.house.education = 2;
-                    if (b->data.house.academy) {
-                        b->data.house.education = 3;
-                    }
-                }
-            }
+    // religion
+    b->data.house.num_gods = 0;
+    if (b->data.house.temple_ceres) {
+        ++b->data.house.num_gods;
+    }
+    if (b->data.house.temple_neptune) {
+        ++b->data.house.num_gods;
+    }
+    if (b->data.house.temple_mercury) {
+        ++b->data.house.num_gods;
+    }
+    if (b->data.house.temple_mars) {
+        ++b->data.house.num_gods;
+    }
+    if (b->data.house.temple_venus) {
+        ++b->data.house.num_gods;
+    }
 
-            // religion
-            b->data.house.num_gods = 0;
-            if (b->data.house.temple_ceres) {
-                ++b->data.house.num_gods;
-            }
-            if (b->data.house.temple_neptune) {
-                ++b->data.house.num_gods;
-            }
-            if (b->data.house.temple_mercury) {
-                ++b->data.house.num_gods;
-            }
-            if (b->data.house.temple_mars) {
-                ++b->data.house.num_gods;
-            }
-            if (b->data.house.temple_venus) {
-                ++b->data.house.num_gods;
-            }
+    // health
+    b->data.house.health = 0;
+    if (b->data.house.clinic) {
+        ++b->data.house.health;
+    }
+    if (b->data.house.hospital) {
+        ++b->data.house.health;
+    }
+}
 
-            // health
-            b->data.house.health = 0;
-            if (b->data.house.clinic) {
-                ++b->data.house.health;
-            }
-            if (b->data.house.hospital) {
-                ++b->data.house.health;
-            }
+static void calculate_aggregates_job(int part, int first, int last, void *userdata)
+{
+    const culture_bonus *bonus = userdata;
+    for (int i = first; i < last; i++) {
+        building *b = building_get(i);
+        if (b->state == BUILDING_STATE_IN_USE && b->house_size &&
+            b->type >= BUILDING_HOUSE_SMALL_TENT && b->type <= BUILDING_HOUSE_LUXURY_PALACE) {
+            calculate_house_aggregates(b, bonus);
         }
     }
 }
+
+void house_service_calculate_culture_aggregates(void)
+{
+    culture_bonus bonus;
+    bonus.venus_module2 = building_monument_gt_module_is_active(VENUS_MODULE_2_DESIRABILITY_ENTERTAINMENT);
+    bonus.completed_colosseum = building_monument_working(BUILDING_COLOSSEUM);
+    bonus.completed_hippodrome = building_monument_working(BUILDING_HIPPODROME);
+
+    // Every house only reads and writes its own data
+    jobs_run(building_count(), MIN_BUILDINGS_PER_JOB_PART, calculate_aggregates_job, &bonus);
+}
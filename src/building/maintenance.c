@@ -57,7 +57,7 @@ void building_maintenance_update_burning_ruins(void)
         b->fire_duration++;
         if (b->fire_duration > 32) {
             game_undo_disable();
-            b->state = BUILDING_STATE_RUBBLE;
+            building_set_state(b, BUILDING_STATE_RUBBLE);
             map_building_tiles_set_rubble(i, b->x, b->y, b->size);
             recalculate_terrain = 1;
             continue;
@@ -257,7 +257,7 @@ void building_maintenance_check_rome_access(void)
                         b->house_population = 0;
                         b->house_unreachable_ticks = 0;
                     }
-                    b->state = BUILDING_STATE_UNDO;
+                    building_set_state(b, BUILDING_STATE_UNDO);
                 }
             } else {
                 int distance = map_routing_distance(map_grid_offset(x_road, y_road));
@@ -277,7 +277,7 @@ void building_maintenance_check_rome_access(void)
                     b->house_unreachable_ticks++;
                     if (b->house_unreachable_ticks > 8) {
                         b->house_unreachable_ticks = 0;
-                        b->state = BUILDING_STATE_UNDO;
+                        building_set_state(b, BUILDING_STATE_UNDO);
                     }
                 }
                 b->road_access_x = x_road;
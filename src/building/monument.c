@@ -774,10 +774,10 @@ int building_monument_is_construction_halted(building *b)
 int building_monument_toggle_construction_halted(building *b)
 {
     if (b->state == BUILDING_STATE_MOTHBALLED) {
-        b->state = BUILDING_STATE_IN_USE;
+        building_set_state(b, BUILDING_STATE_IN_USE);
         return 0;
     } else {
-        b->state = BUILDING_STATE_MOTHBALLED;
+        building_set_state(b, BUILDING_STATE_MOTHBALLED);
         return 1;
     }
 }
@@ -1,6 +1,7 @@
 #include "storage.h"
 
 #include "building/building.h"
+#include "building/warehouse.h"
 #include "city/resource.h"
 #include "core/array.h"
 #include "core/calc.h"
@@ -34,10 +35,12 @@ static int storage_in_use(const data_storage *storage)
 
 void building_storage_clear_all(void)
 {
+    building_warehouses_clear_stock_cache();
     if (!array_init(storages, STORAGE_ARRAY_SIZE_STEP, storage_create, storage_in_use) ||
         !array_next(storages)) { // Ignore first storage
         log_error("Unable to create storages. The game will likely crash.", 0, 0);
     }
+    array_track_free_slots(storages);
 }
 
 int building_storage_get_array_size(void)
@@ -93,6 +96,7 @@ int building_storage_restore(int storage_id)
         return 0;
     }
     array_item(storages, storage_id)->in_use = 1;
+    building_warehouses_clear_stock_cache();
     if (storage_id >= storages.size) {
         storages.size = storage_id + 1;
     }
@@ -102,6 +106,7 @@ int building_storage_restore(int storage_id)
 void building_storage_delete(int storage_id)
 {
     array_item(storages, storage_id)->in_use = 0;
+    array_item_freed(storages, storage_id);
     array_trim(storages);
 }
 
@@ -286,10 +291,13 @@ void building_storage_load_state(buffer *buf, int version)
 
     int storages_to_load = (int) buf_size / storage_buf_size;
 
+    building_warehouses_clear_stock_cache();
+
     if (!array_init(storages, STORAGE_ARRAY_SIZE_STEP, storage_create, storage_in_use) ||
         !array_expand(storages, storages_to_load)) {
         log_error("Unable to create storages. The game will likely crash.", 0, 0);
     }
+    array_track_free_slots(storages);
 
     int highest_id_in_use = 0;
 
@@ -9,6 +9,7 @@
 #include "building/storage.h"
 #include "city/finance.h"
 #include "city/resource.h"
+#include "core/array.h"
 #include "core/calc.h"
 #include "core/image.h"
 #include "empire/trade_prices.h"
@@ -17,29 +18,120 @@
 #include "map/image.h"
 #include "scenario/property.h"
 
+#include <string.h>
+
 #define INFINITE 10000
 
 #define MAX_CARTLOADS_PER_SPACE 4
 
-int building_warehouse_get_space_info(building *warehouse)
+#define STOCK_ARRAY_SIZE_STEP 200
+
+typedef struct {
+    int building_id;
+    unsigned short created_sequence;
+    unsigned char is_valid;
+    unsigned char is_complete;
+    unsigned char empty_spaces;
+    short total_loads;
+    short loads[RESOURCE_MAX];
+    unsigned char non_full_spaces[RESOURCE_MAX];
+} warehouse_stock;
+
+// Per-warehouse summary of the eight storage spaces, indexed by storage id.
+// Not saved: entries are rebuilt lazily after a space changes or a game is loaded.
+static struct {
+    array(warehouse_stock) entries;
+    warehouse_stock scratch;
+} stock_cache;
+
+static void calculate_stock(warehouse_stock *stock, building *warehouse)
 {
-    int total_loads = 0;
-    int empty_spaces = 0;
+    memset(stock, 0, sizeof(warehouse_stock));
+    stock->building_id = warehouse->id;
+    stock->created_sequence = warehouse->created_sequence;
+    stock->is_valid = 1;
+    stock->is_complete = 1;
     building *space = warehouse;
     for (int i = 0; i < 8; i++) {
         space = building_next(space);
         if (space->id <= 0) {
-            return 0;
+            stock->is_complete = 0;
+            continue;
         }
-        if (space->subtype.warehouse_resource_id) {
-            total_loads += space->resources[space->subtype.warehouse_resource_id];
-        } else {
-            empty_spaces++;
+        int resource = space->subtype.warehouse_resource_id;
+        if (resource == RESOURCE_NONE) {
+            stock->empty_spaces++;
+            continue;
+        }
+        stock->loads[resource] += space->resources[resource];
+        stock->total_loads += space->resources[resource];
+        if (space->resources[resource] < MAX_CARTLOADS_PER_SPACE) {
+            stock->non_full_spaces[resource]++;
+        }
+    }
+    // Warehouses that are still missing spaces are recalculated on every use
+    stock->is_valid = stock->is_complete;
+}
+
+static warehouse_stock *get_stock_entry(int storage_id)
+{
+    if (storage_id <= 0) {
+        return 0;
+    }
+    if (!stock_cache.entries.blocks && !array_init(stock_cache.entries, STOCK_ARRAY_SIZE_STEP, 0, 0)) {
+        return 0;
+    }
+    // Storage ids come from the storages array, so the cache grows along with it
+    while (stock_cache.entries.size <= (unsigned int) storage_id) {
+        if (!array_advance(stock_cache.entries)) {
+            return 0;
         }
     }
-    if (empty_spaces > 0) {
+    return array_item(stock_cache.entries, storage_id);
+}
+
+static const warehouse_stock *get_stock(building *warehouse)
+{
+    warehouse_stock *stock = get_stock_entry(warehouse->storage_id);
+    if (!stock) {
+        // No storage to key on or out of memory, don't cache
+        stock = &stock_cache.scratch;
+        stock->is_valid = 0;
+    }
+    if (!stock->is_valid || stock->building_id != warehouse->id ||
+        stock->created_sequence != warehouse->created_sequence) {
+        calculate_stock(stock, warehouse);
+    }
+    return stock;
+}
+
+static void invalidate_stock(building *space)
+{
+    building *warehouse = building_main(space);
+    if (warehouse->storage_id <= 0 || (unsigned int) warehouse->storage_id >= stock_cache.entries.size) {
+        return;
+    }
+    warehouse_stock *stock = array_item(stock_cache.entries, warehouse->storage_id);
+    if (stock->building_id == warehouse->id) {
+        stock->is_valid = 0;
+    }
+}
+
+void building_warehouses_clear_stock_cache(void)
+{
+    array_clear(stock_cache.entries);
+    memset(&stock_cache.scratch, 0, sizeof(warehouse_stock));
+}
+
+int building_warehouse_get_space_info(building *warehouse)
+{
+    const warehouse_stock *stock = get_stock(warehouse);
+    if (!stock->is_complete) {
+        return 0;
+    }
+    if (stock->empty_spaces > 0) {
         return WAREHOUSE_ROOM;
-    } else if (total_loads < FULL_WAREHOUSE) {
+    } else if (stock->total_loads < FULL_WAREHOUSE) {
         return WAREHOUSE_SOME_ROOM;
     } else {
         return WAREHOUSE_FULL;
@@ -48,18 +140,11 @@ int building_warehouse_get_space_info(building *warehouse)
 
 int building_warehouse_get_amount(building *warehouse, int resource)
 {
-    int loads = 0;
-    building *space = warehouse;
-    for (int i = 0; i < 8; i++) {
-        space = building_next(space);
-        if (space->id <= 0) {
-            return 0;
-        }
-        if (space->subtype.warehouse_resource_id && space->subtype.warehouse_resource_id == resource) {
-            loads += space->resources[resource];
-        }
+    if (resource <= RESOURCE_NONE || resource >= RESOURCE_MAX) {
+        return 0;
     }
-    return loads;
+    const warehouse_stock *stock = get_stock(warehouse);
+    return stock->is_complete ? stock->loads[resource] : 0;
 }
 
 int building_warehouse_add_resource(building *b, int resource, int respect_settings)
@@ -216,6 +301,8 @@ void building_warehouse_remove_resource_curse(building *warehouse, int amount)
 
 void building_warehouse_space_set_image(building *space, int resource)
 {
+    // Every change to a space's contents ends up here
+    invalidate_stock(space);
     int image_id;
     if (building_loads_stored(space) <= 0) {
         image_id = image_group(GROUP_BUILDING_WAREHOUSE_STORAGE_EMPTY);
@@ -487,6 +574,11 @@ int building_warehouse_accepts_storage(building *b, int resource, int *understaf
         }
         return 0;
     }
+    const warehouse_stock *stock = get_stock(b);
+    if (stock->is_complete) {
+        return stock->empty_spaces > 0 ||
+            (resource > RESOURCE_NONE && resource < RESOURCE_MAX && stock->non_full_spaces[resource] > 0);
+    }
     building *space = b;
     for (int t = 0; t < 8; t++) {
         space = building_next(space);
@@ -525,15 +617,10 @@ int building_warehouse_for_storing(int src_building_id, int x, int y, int resour
 
 int building_warehouse_amount_can_get_from(building *destination, int resource)
 {
-    int loads_stored = 0;
-    building *space = destination;
-    for (int t = 0; t < 8; t++) {
-        space = building_next(space);
-        if (space->id > 0 && space->subtype.warehouse_resource_id == resource) {
-            loads_stored += space->resources[resource];
-        }
+    if (resource <= RESOURCE_NONE || resource >= RESOURCE_MAX) {
+        return 0;
     }
-    return loads_stored;
+    return get_stock(destination)->loads[resource];
 }
 
 int building_warehouse_for_getting(building *src, int resource, map_point *dst)
@@ -589,14 +676,7 @@ int building_warehouse_with_resource(int x, int y, int resource, int road_networ
             }
             continue;
         }
-        int loads_stored = 0;
-        building *space = b;
-        for (int t = 0; t < 8; t++) {
-            space = building_next(space);
-            if (space->id > 0 && space->subtype.warehouse_resource_id == resource) {
-                loads_stored += space->resources[resource];
-            }
-        }
+        int loads_stored = building_warehouse_amount_can_get_from(b, resource);
         if (loads_stored > 0) {
             int dist = calc_maximum_distance(b->x, b->y, x, y);
             dist -= 2 * loads_stored;
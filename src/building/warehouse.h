@@ -22,6 +22,11 @@ enum {
     WAREHOUSE_TASK_DELIVERING = 1
 };
 
+/**
+ * Drops the cached per-warehouse stock totals, to be called when buildings or storages are replaced wholesale
+ */
+void building_warehouses_clear_stock_cache(void);
+
 int building_warehouse_get_space_info(building *warehouse);
 
 int building_warehouse_get_amount(building *warehouse, int resource);
@@ -9,6 +9,9 @@
 #include "city/festival.h"
 #include "city/population.h"
 #include "core/calc.h"
+#include "core/jobs.h"
+
+#include <string.h>
 
 #define LARARIUM_COVERAGE 10
 #define SHRINE_COVERAGE 50
@@ -19,6 +22,18 @@
 #define PANTHEON_COVERAGE 1500
 #define GRAND_TEMPLE_COVERAGE 5000
 
+#define MIN_BUILDINGS_PER_JOB_PART 1000
+
+typedef struct {
+    int num_houses;
+    int entertainment;
+    int religion;
+    int education;
+    int health;
+    int desirability;
+    int population_with_venus_access;
+} culture_sums;
+
 
 static struct {
     int theater;
@@ -228,6 +243,27 @@ void city_culture_update_coverage(void)
         HOSPITAL_COVERAGE * building_count_active(BUILDING_HOSPITAL), population));
 }
 
+static void sum_house_culture_job(int part, int first, int last, void *userdata)
+{
+    culture_sums *sums = &((culture_sums *) userdata)[part];
+    memset(sums, 0, sizeof(culture_sums));
+    for (int i = first; i < last; i++) {
+        const building *b = building_get(i);
+        if (b->state == BUILDING_STATE_IN_USE && b->house_size &&
+            b->type >= BUILDING_HOUSE_SMALL_TENT && b->type <= BUILDING_HOUSE_LUXURY_PALACE) {
+            sums->num_houses++;
+            sums->entertainment += b->data.house.entertainment;
+            sums->religion += b->data.house.num_gods;
+            sums->education += b->data.house.education;
+            sums->health += b->data.house.health;
+            sums->desirability += b->desirability;
+            if (b->data.house.temple_venus) {
+                sums->population_with_venus_access += b->house_population;
+            }
+        }
+    }
+}
+
 void city_culture_calculate(void)
 {
     city_data.culture.average_entertainment = 0;
@@ -237,21 +273,17 @@ void city_culture_calculate(void)
     city_data.culture.average_desirability = 0;
     city_data.culture.population_with_venus_access = 0; //venus
 
+    culture_sums sums[JOBS_MAX_PARTS];
+    int num_parts = jobs_run(building_count(), MIN_BUILDINGS_PER_JOB_PART, sum_house_culture_job, sums);
     int num_houses = 0;
-    for (building_type type = BUILDING_HOUSE_SMALL_TENT; type <= BUILDING_HOUSE_LUXURY_PALACE; type++) {
-        for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-            if (b->state == BUILDING_STATE_IN_USE && b->house_size) {
-                num_houses++;
-                city_data.culture.average_entertainment += b->data.house.entertainment;
-                city_data.culture.average_religion += b->data.house.num_gods;
-                city_data.culture.average_education += b->data.house.education;
-                city_data.culture.average_health += b->data.house.health;
-                city_data.culture.average_desirability += b->desirability;
-                if (b->data.house.temple_venus) {
-                    city_data.culture.population_with_venus_access += b->house_population;
-                }
-            }
-        }
+    for (int i = 0; i < num_parts; i++) {
+        num_houses += sums[i].num_houses;
+        city_data.culture.average_entertainment += sums[i].entertainment;
+        city_data.culture.average_religion += sums[i].religion;
+        city_data.culture.average_education += sums[i].education;
+        city_data.culture.average_health += sums[i].health;
+        city_data.culture.average_desirability += sums[i].desirability;
+        city_data.culture.population_with_venus_access += sums[i].population_with_venus_access;
     }
     if (num_houses) {
         city_data.culture.average_entertainment /= num_houses;
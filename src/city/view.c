@@ -525,6 +525,33 @@ int city_view_tile_to_grid_offset(const view_tile *tile)
     return grid_offset < 0 ? 0 : grid_offset;
 }
 
+int city_view_get_grid_offset_at_view_tile(int x_view, int y_view)
+{
+    if (x_view < 0 || x_view >= VIEW_X_MAX || y_view < 0 || y_view >= VIEW_Y_MAX) {
+        return -1;
+    }
+    return view_to_grid_offset_lookup[x_view][y_view];
+}
+
+void city_view_get_view_tile_pixel_position(int x_view, int y_view, int *x_pixels, int *y_pixels)
+{
+    // Same unscaled position as given to the callbacks of city_view_foreach_valid_map_tile
+    *x_pixels = data.viewport.x + TILE_WIDTH_PIXELS * (x_view - data.camera.tile.x) - data.camera.pixel.x;
+    if (y_view & 1) {
+        *x_pixels -= HALF_TILE_WIDTH_PIXELS;
+    }
+    *y_pixels = data.viewport.y + HALF_TILE_HEIGHT_PIXELS * (y_view - data.camera.tile.y - 1) - data.camera.pixel.y;
+}
+
+void city_view_get_valid_view_tile_range(view_tile *first, view_tile *last)
+{
+    // Same range as city_view_foreach_valid_map_tile
+    first->x = calc_bound(data.camera.tile.x - 6, 0, VIEW_X_MAX - 1);
+    first->y = calc_bound(data.camera.tile.y - 8, 0, VIEW_Y_MAX - 1);
+    last->x = calc_bound(data.camera.tile.x - 6 + data.viewport.width_tiles + 8, 0, VIEW_X_MAX - 1);
+    last->y = calc_bound(data.camera.tile.y - 8 + data.viewport.height_tiles + 20, 0, VIEW_Y_MAX - 1);
+}
+
 void city_view_go_to_grid_offset(int grid_offset)
 {
     int x, y;
@@ -58,6 +58,12 @@ void city_view_set_selected_view_tile(const view_tile *tile);
 
 int city_view_tile_to_grid_offset(const view_tile *tile);
 
+int city_view_get_grid_offset_at_view_tile(int x_view, int y_view);
+
+void city_view_get_view_tile_pixel_position(int x_view, int y_view, int *x_pixels, int *y_pixels);
+
+void city_view_get_valid_view_tile_range(view_tile *first, view_tile *last);
+
 void city_view_go_to_grid_offset(int grid_offset);
 
 void city_view_rotate_left(void);
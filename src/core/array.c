@@ -28,3 +28,57 @@ void array_free(void **data, unsigned int blocks)
     }
     free(data);
 }
+
+static int resize_free_slots(uint32_t **slots, unsigned int *slots_size, unsigned int new_size)
+{
+    // Sizes are kept at a multiple of 32 bits
+    new_size = (new_size + 31) & ~31u;
+    uint32_t *new_slots = realloc(*slots, new_size / 8);
+    if (!new_slots) {
+        // Not fatal: without the bitmap, every item is checked instead
+        free(*slots);
+        *slots = 0;
+        *slots_size = 0;
+        return 0;
+    }
+    memset((uint8_t *) new_slots + *slots_size / 8, 0xff, (new_size - *slots_size) / 8);
+    *slots = new_slots;
+    *slots_size = new_size;
+    return 1;
+}
+
+void array_free_slots_enable(uint32_t **slots, unsigned int *slots_size, unsigned int size)
+{
+    free(*slots);
+    *slots = 0;
+    *slots_size = 0;
+    resize_free_slots(slots, slots_size, size > 32 ? size : 32);
+}
+
+void array_free_slots_set(uint32_t **slots, unsigned int *slots_size, unsigned int position)
+{
+    if (position >= *slots_size && !resize_free_slots(slots, slots_size, position * 2 + 1)) {
+        return;
+    }
+    (*slots)[position >> 5] |= 1u << (position & 31);
+}
+
+unsigned int array_free_slots_next(const uint32_t *slots, unsigned int slots_size, unsigned int start,
+    unsigned int end)
+{
+    unsigned int limit = end < slots_size ? end : slots_size;
+    unsigned int position = start;
+    while (position < limit) {
+        uint32_t word = slots[position >> 5] >> (position & 31);
+        if (word) {
+            while (!(word & 1)) {
+                word >>= 1;
+                position++;
+            }
+            return position < limit ? position : end;
+        }
+        position = (position | 31) + 1;
+    }
+    // Positions that aren't tracked may be free
+    return position < end ? position : end;
+}
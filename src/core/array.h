@@ -1,6 +1,7 @@
 #ifndef CORE_ARRAY_H
 #define CORE_ARRAY_H
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -17,6 +18,8 @@ struct { \
     unsigned int bit_offset; \
     void (*constructor)(T *, unsigned int); \
     int (*in_use)(const T *); \
+    uint32_t *free_slots; \
+    unsigned int free_slots_size; \
 }
 
 /**
@@ -26,6 +29,7 @@ struct { \
 #define array_clear(a) \
 ( \
     array_free((void **)(a).items, (a).blocks), \
+    free((a).free_slots), \
     memset(&(a), 0, sizeof(a)) \
 )
 
@@ -53,6 +57,25 @@ struct { \
     array_create_blocks(a, 1) \
 )
 
+/**
+ * Keeps track of which items may be free, so that creating a new item doesn't need to check every used item.
+ * The lowest free position is still the one that gets reused, so the order in which items are created is the same.
+ * Should be called right after array_init and requires an in_use callback.
+ * When tracking, array_item_freed MUST be called whenever an item stops being in use.
+ * If memory can't be allocated, the array silently goes back to checking every item.
+ * @param a The array structure
+ */
+#define array_track_free_slots(a) \
+    array_free_slots_enable(&(a).free_slots, &(a).free_slots_size, (a).size)
+
+/**
+ * Tells a tracking array that an item is no longer in use. Does nothing if the array doesn't track free slots.
+ * @param a The array structure
+ * @param position The position of the item that is no longer in use
+ */
+#define array_item_freed(a, position) \
+    ((a).free_slots ? array_free_slots_set(&(a).free_slots, &(a).free_slots_size, position) : (void) 0)
+
 /**
  * Creates a new item for the array, either by finding an available empty item or by expanding the array.
  * @param a The array structure
@@ -63,7 +86,8 @@ struct { \
     ptr = 0; \
     int error = 0; \
     if ((a).in_use) { \
-        for (unsigned int array_index = 0; array_index < (a).size; array_index++) { \
+        for (unsigned int array_index = array_first_free_slot(a, 0); array_index < (a).size; \
+            array_index = array_first_free_slot(a, array_index + 1)) { \
             if (!(a).in_use(array_item(a, array_index))) { \
                 ptr = array_item(a, array_index); \
                 memset(ptr, 0, sizeof(**(a).items)); \
@@ -72,6 +96,7 @@ struct { \
                 } \
                 break; \
             } \
+            array_free_slot_used(a, array_index); \
         } \
     } \
     if (!error && !ptr) { \
@@ -97,7 +122,8 @@ struct { \
         } \
     } \
     if (!error && (a).in_use) { \
-        for (unsigned int array_index = index; array_index < (a).size; array_index++) { \
+        for (unsigned int array_index = array_first_free_slot(a, index); array_index < (a).size; \
+            array_index = array_first_free_slot(a, array_index + 1)) { \
             if (!(a).in_use(array_item(a, array_index))) { \
                 ptr = array_item(a, array_index); \
                 memset(ptr, 0, sizeof(**(a).items)); \
@@ -106,6 +132,7 @@ struct { \
                 } \
                 break; \
             } \
+            array_free_slot_used(a, array_index); \
         } \
     } \
     if (!error && !ptr) { \
@@ -130,6 +157,7 @@ struct { \
         memset(array_item(a, (a).size - 1), 0, sizeof(**(a).items)); \
         (a).size--; \
     } \
+    array_free_slots_reset(a); \
 }
 
 /**
@@ -235,6 +263,7 @@ struct { \
             } \
             (a).size -= items_to_move; \
         } \
+        array_free_slots_reset(a); \
     } \
 }
 
@@ -259,6 +288,7 @@ struct { \
 ( \
     memset(array_item(a, (a).size), 0, sizeof(**(a).items)), \
     (a).constructor ? (a).constructor(array_item(a, (a).size), (a).size) : (void) 0, \
+    array_item_freed(a, (a).size), \
     (a).size++, \
     array_item(a, (a).size - 1) \
 )
@@ -271,6 +301,33 @@ struct { \
     array_add_blocks((void ***)&(a).items, &(a).blocks, (a).block_offset + 1, sizeof(**(a).items), num_blocks) \
 )
 
+/**
+ * These definitions are private and should not be used
+ */
+#define array_first_free_slot(a, start) \
+( \
+    (a).free_slots ? array_free_slots_next((a).free_slots, (a).free_slots_size, start, (a).size) : (start) \
+)
+
+#define array_free_slot_used(a, position) \
+( \
+    (a).free_slots && (position) < (a).free_slots_size ? \
+    (void) ((a).free_slots[(position) >> 5] &= ~(1u << ((position) & 31))) : (void) 0 \
+)
+
+#define array_free_slots_reset(a) \
+( \
+    (a).free_slots ? (void) memset((a).free_slots, 0xff, (a).free_slots_size / 8) : (void) 0 \
+)
+
+/**
+ * These functions are private and should not be used
+ */
+void array_free_slots_enable(uint32_t **slots, unsigned int *slots_size, unsigned int size);
+void array_free_slots_set(uint32_t **slots, unsigned int *slots_size, unsigned int position);
+unsigned int array_free_slots_next(const uint32_t *slots, unsigned int slots_size, unsigned int start,
+    unsigned int end);
+
 /**
  * This function is private and should not be used
  */
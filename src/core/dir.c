@@ -5,16 +5,35 @@
 #include "core/string.h"
 #include "platform/file_manager.h"
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #define BASE_MAX_FILES 100
+#define RESOLVED_PATH_BUCKETS 1024
+#define MAX_RESOLVED_PATHS 4096
+
+typedef struct resolved_path {
+    char *dir;
+    char *filepath;
+    char *result;
+    char *checked_dir;
+    int checked_dir_exists;
+    long checked_dir_modified_time;
+    struct resolved_path *next;
+} resolved_path;
 
 static struct {
     dir_listing listing;
     int max_files;
     char *cased_filename;
     char current_dir[FILE_NAME_MAX];
+    char corrected_filename[2 * FILE_NAME_MAX];
+    struct {
+        resolved_path *buckets[RESOLVED_PATH_BUCKETS];
+        int total;
+    } resolved_paths;
 } data;
 
 static void allocate_listing_files(int min, int max)
@@ -122,9 +141,135 @@ static void move_left(char *str)
     *str = 0;
 }
 
+static unsigned int get_resolved_path_bucket(const char *dir, const char *filepath)
+{
+    uint32_t hash = 2166136261u;
+    for (const char *c = dir; *c; c++) {
+        hash = (hash ^ (uint8_t) *c) * 16777619u;
+    }
+    hash = (hash ^ '/') * 16777619u;
+    for (const char *c = filepath; *c; c++) {
+        hash = (hash ^ (uint8_t) *c) * 16777619u;
+    }
+    return hash % RESOLVED_PATH_BUCKETS;
+}
+
+static char *copy_string(const char *str)
+{
+    size_t size = strlen(str) + 1;
+    char *copy = malloc(size);
+    if (copy) {
+        memcpy(copy, str, size);
+    }
+    return copy;
+}
+
+static void free_resolved_path(resolved_path *entry)
+{
+    free(entry->dir);
+    free(entry->filepath);
+    free(entry->result);
+    free(entry->checked_dir);
+    free(entry);
+}
+
+static void clear_resolved_paths(void)
+{
+    for (int i = 0; i < RESOLVED_PATH_BUCKETS; i++) {
+        resolved_path *entry = data.resolved_paths.buckets[i];
+        while (entry) {
+            resolved_path *next = entry->next;
+            free_resolved_path(entry);
+            entry = next;
+        }
+        data.resolved_paths.buckets[i] = 0;
+    }
+    data.resolved_paths.total = 0;
+}
+
+static int resolved_path_is_valid(const resolved_path *entry)
+{
+    long modified_time;
+    int exists = platform_file_manager_get_modified_time(entry->checked_dir, &modified_time);
+    return exists == entry->checked_dir_exists && modified_time == entry->checked_dir_modified_time;
+}
+
+// Returns the path resolved by an earlier call, as long as the directory it was checked against didn't change
+static const resolved_path *get_resolved_path(const char *dir, const char *filepath)
+{
+    resolved_path **link = &data.resolved_paths.buckets[get_resolved_path_bucket(dir, filepath)];
+    for (resolved_path *entry = *link; entry; link = &entry->next, entry = entry->next) {
+        if (strcmp(entry->filepath, filepath) != 0 || strcmp(entry->dir, dir) != 0) {
+            continue;
+        }
+        if (resolved_path_is_valid(entry)) {
+            return entry;
+        }
+        *link = entry->next;
+        free_resolved_path(entry);
+        data.resolved_paths.total--;
+        return 0;
+    }
+    return 0;
+}
+
+static void get_parent_dir(const char *path, char *parent)
+{
+    const char *slash = strrchr(path, '/');
+    if (!slash) {
+        snprintf(parent, 2 * FILE_NAME_MAX, ".");
+    } else if (slash == path) {
+        snprintf(parent, 2 * FILE_NAME_MAX, "/");
+    } else {
+        snprintf(parent, 2 * FILE_NAME_MAX, "%.*s", (int) (slash - path), path);
+    }
+}
+
+// Found files are checked against their directory, missing ones against the last directory they were searched in
+static const char *add_resolved_path(const char *dir, const char *filepath, const char *result, const char *checked_dir)
+{
+    char parent[2 * FILE_NAME_MAX];
+    if (result) {
+        get_parent_dir(result, parent);
+        checked_dir = parent;
+    }
+    if (!*checked_dir) {
+        return result;
+    }
+    long modified_time;
+    int exists = platform_file_manager_get_modified_time(checked_dir, &modified_time);
+    // Timestamps only have a precision of seconds, so a directory that changed just now may change again unnoticed
+    if (exists && modified_time >= (long) time(0) - 1) {
+        return result;
+    }
+    if (data.resolved_paths.total >= MAX_RESOLVED_PATHS) {
+        clear_resolved_paths();
+    }
+    resolved_path *entry = malloc(sizeof(resolved_path));
+    if (!entry) {
+        return result;
+    }
+    memset(entry, 0, sizeof(resolved_path));
+    entry->dir = copy_string(dir);
+    entry->filepath = copy_string(filepath);
+    entry->result = result ? copy_string(result) : 0;
+    entry->checked_dir = copy_string(checked_dir);
+    if (!entry->dir || !entry->filepath || (result && !entry->result) || !entry->checked_dir) {
+        free_resolved_path(entry);
+        return result;
+    }
+    entry->checked_dir_exists = exists;
+    entry->checked_dir_modified_time = modified_time;
+    unsigned int bucket = get_resolved_path_bucket(dir, filepath);
+    entry->next = data.resolved_paths.buckets[bucket];
+    data.resolved_paths.buckets[bucket] = entry;
+    data.resolved_paths.total++;
+    return result;
+}
+
 static const char *get_case_corrected_file(const char *dir, const char *filepath)
 {
-    static char corrected_filename[2 * FILE_NAME_MAX];
+    char *corrected_filename = data.corrected_filename;
     char backup[2 * FILE_NAME_MAX];
     size_t backup_offset = 0;
 
@@ -139,6 +284,20 @@ static const char *get_case_corrected_file(const char *dir, const char *filepath
         filepath = backup;
     }
 
+    const char *requested_dir = dir ? dir : "";
+    int should_case_correct = platform_file_manager_should_case_correct_file();
+    if (should_case_correct) {
+        // Looking for a file with the wrong case lists every directory on its path, so remember the result
+        const resolved_path *resolved = get_resolved_path(requested_dir, filepath);
+        if (resolved) {
+            if (!resolved->result) {
+                return 0;
+            }
+            snprintf(corrected_filename, 2 * FILE_NAME_MAX, "%s", resolved->result);
+            return corrected_filename;
+        }
+    }
+
     size_t dir_len = 0;
     size_t dir_skip = 0;
     if (!dir || !*dir) {
@@ -159,10 +318,13 @@ static const char *get_case_corrected_file(const char *dir, const char *filepath
     FILE *fp = file_open(corrected_filename, "rb");
     if (fp) {
         file_close(fp);
+        if (should_case_correct) {
+            return add_resolved_path(requested_dir, filepath, corrected_filename + dir_skip, 0);
+        }
         return corrected_filename + dir_skip;
     }
 
-    if (!platform_file_manager_should_case_correct_file()) {
+    if (!should_case_correct) {
         if (filepath == backup) {
             snprintf(corrected_filename + backup_offset, 2 * FILE_NAME_MAX - backup_offset, "%s", backup);
         }
@@ -182,6 +344,7 @@ static const char *get_case_corrected_file(const char *dir, const char *filepath
         }
         *slash = 0;
         if (!correct_case(corrected_filename, &corrected_filename[path_offset], TYPE_DIR)) {
+            add_resolved_path(requested_dir, filepath, 0, corrected_filename);
             if (filepath == backup) {
                 snprintf(corrected_filename + backup_offset, 2 * FILE_NAME_MAX - backup_offset, "%s", backup);
             }
@@ -196,13 +359,14 @@ static const char *get_case_corrected_file(const char *dir, const char *filepath
         path_offset += strlen(&corrected_filename[path_offset]) + 1;
     }
     if (!correct_case(corrected_filename, &corrected_filename[path_offset], TYPE_FILE)) {
+        add_resolved_path(requested_dir, filepath, 0, corrected_filename);
         if (filepath == backup) {
             snprintf(corrected_filename + backup_offset, 2 * FILE_NAME_MAX - backup_offset, "%s", backup);
         }
         return 0;
     }
     corrected_filename[path_offset - 1] = '/';
-    return corrected_filename + dir_skip;
+    return add_resolved_path(requested_dir, filepath, corrected_filename + dir_skip, 0);
 }
 
 const dir_listing *dir_append_files_with_extension(const char *extension)
@@ -92,3 +92,8 @@ int file_remove(const char *filename)
 {
     return platform_file_manager_remove_file(filename);
 }
+
+int file_rename(const char *src, const char *dst)
+{
+    return platform_file_manager_rename_file(src, dst);
+}
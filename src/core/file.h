@@ -93,4 +93,12 @@ int file_exists(const char *filename, int localizable);
  */
 int file_remove(const char *filename);
 
+/**
+ * Rename a file, replacing the destination if it already exists
+ * @param src Filename to rename
+ * @param dst New filename
+ * @return boolean true if the file was renamed, false otherwise
+ */
+int file_rename(const char *src, const char *dst);
+
 #endif // CORE_FILE_H
@@ -126,7 +126,9 @@ static const char *ini_keys[] = {
     "show_empire_map",
     "show_messages",
     "show_overlay_native",
-    "build_highway"
+    "build_highway",
+    "toggle_tick_profiler",
+    "save_tick_profile"
 };
 
 static struct {
@@ -113,6 +113,8 @@ typedef enum {
     HOTKEY_SHOW_MESSAGES,
     HOTKEY_SHOW_OVERLAY_RISKS_NATIVE,
     HOTKEY_BUILD_HIGHWAY,
+    HOTKEY_TOGGLE_TICK_PROFILER,
+    HOTKEY_SAVE_TICK_PROFILE,
     HOTKEY_MAX_ITEMS
 } hotkey_action;
 
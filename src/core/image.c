@@ -5,13 +5,26 @@
 #include "core/file.h"
 #include "core/image_packer.h"
 #include "core/io.h"
+#include "core/jobs.h"
 #include "core/log.h"
+#include "game/system.h"
 #include "graphics/font.h"
 #include "graphics/renderer.h"
 
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define USE_SSE2_CONVERSION
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && (!defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define USE_NEON_CONVERSION
+#include <arm_neon.h>
+#endif
+
+#define PIXEL_BLOCK_SIZE 8
+#define MIN_IMAGES_PER_JOB_PART 256
+
 #define HEADER_SIZE 20680
 #define ENTRY_SIZE 64
 
@@ -60,6 +73,14 @@ typedef struct {
     void *buffer;
 } image_draw_data;
 
+typedef struct {
+    const buffer *buf;
+    image *images;
+    image_draw_data *draw_datas;
+    const image_atlas_data *atlas_data;
+    atlas_type type;
+} image_job;
+
 typedef struct {
     int width;
     int height;
@@ -332,6 +353,52 @@ static int prepare_images(buffer *buf, image *images, image_draw_data *draw_data
 static void convert_compressed(buffer *buf, int width, int height, int x_offset, int y_offset,
     int buf_length, color_t *dst, int dst_width);
 
+static int is_placeholder_image(atlas_type type, int index)
+{
+    return type == ATLAS_MAIN && index >= 6145 && index <= 6192;
+}
+
+static void decode_compressed_job(int part, int first, int last, void *userdata)
+{
+    const image_job *job = userdata;
+    buffer buf = *job->buf;
+    for (int i = first > 0 ? first : 1; i < last; i++) {
+        image *img = &job->images[i];
+        image_draw_data *draw_data = &job->draw_datas[i];
+
+        // Don't load original placeholder images
+        if (image_is_external(img) || is_placeholder_image(job->type, i)) {
+            continue;
+        }
+        if (!img->is_isometric && draw_data->is_compressed) {
+            draw_data->buffer = malloc(sizeof(color_t) * img->width * img->height);
+            if (draw_data->buffer) {
+                memset(draw_data->buffer, 0, sizeof(color_t) * img->width * img->height);
+                buffer_set(&buf, draw_data->offset);
+                convert_compressed(&buf, img->width, img->height, 0, 0,
+                    draw_data->data_length, draw_data->buffer, img->width);
+                image_crop(img, draw_data->buffer);
+            }
+        }
+        if (img->top) {
+            draw_data->buffer = malloc(sizeof(color_t) * img->top->width * img->top->height);
+            if (draw_data->buffer) {
+                img->top->original.width = img->top->width;
+                img->top->original.height = img->top->height;
+                memset(draw_data->buffer, 0, sizeof(color_t) * img->top->width * img->top->height);
+                buffer_set(&buf, draw_data->offset + draw_data->uncompressed_length);
+                convert_compressed(&buf, img->top->width, img->top->height, 0, 0,
+                    draw_data->data_length - draw_data->uncompressed_length, draw_data->buffer, img->top->width);
+                image_crop(img->top, draw_data->buffer);
+                if (!img->top->height) {
+                    free(img->top);
+                    img->top = 0;
+                }
+            }
+        }
+    }
+}
+
 static int crop_and_pack_images(buffer *buf, image *images, image_draw_data *draw_datas,
     int num_images, atlas_type type)
 {
@@ -344,7 +411,7 @@ static int crop_and_pack_images(buffer *buf, image *images, image_draw_data *dra
     data.packer.options.sort_by = IMAGE_PACKER_SORT_BY_AREA;
 
     int offset = 4;
-    for (int i = 1, rect = 1; i < num_images; i++, rect++) {
+    for (int i = 1; i < num_images; i++) {
         image *img = &images[i];
         image_draw_data *draw_data = &draw_datas[i];
 
@@ -360,42 +427,23 @@ static int crop_and_pack_images(buffer *buf, image *images, image_draw_data *dra
         }
         draw_data->offset = offset;
         offset += draw_data->data_length;
+    }
 
-        // Don't load original placeholder images
-        if (type == ATLAS_MAIN && i >= 6145 && i <= 6192) {
+    // Every image is decoded from its own part of the file into its own buffer
+    image_job job = { buf, images, draw_datas, 0, type };
+    jobs_run(num_images, MIN_IMAGES_PER_JOB_PART, decode_compressed_job, &job);
+
+    for (int i = 1, rect = 1; i < num_images; i++, rect++) {
+        image *img = &images[i];
+        if (image_is_external(img) || is_placeholder_image(type, i)) {
             continue;
         }
-        if (!img->is_isometric && draw_data->is_compressed) {
-            draw_data->buffer = malloc(sizeof(color_t) * img->width * img->height);
-            if (draw_data->buffer) {
-                memset(draw_data->buffer, 0, sizeof(color_t) * img->width * img->height);
-                buffer_set(buf, draw_data->offset);
-                convert_compressed(buf, img->width, img->height, 0, 0,
-                    draw_data->data_length, draw_data->buffer, img->width);
-                image_crop(img, draw_data->buffer);
-            }
-        }
         data.packer.rects[rect].input.width = img->width;
         data.packer.rects[rect].input.height = img->height;
-        if (img->top) {
-            draw_data->buffer = malloc(sizeof(color_t) * img->top->width * img->top->height);
-            if (draw_data->buffer) {
-                img->top->original.width = img->top->width;
-                img->top->original.height = img->top->height;
-                memset(draw_data->buffer, 0, sizeof(color_t) * img->top->width * img->top->height);
-                buffer_set(buf, draw_data->offset + draw_data->uncompressed_length);
-                convert_compressed(buf, img->top->width, img->top->height, 0, 0,
-                    draw_data->data_length - draw_data->uncompressed_length, draw_data->buffer, img->top->width);
-                image_crop(img->top, draw_data->buffer);
-                if (!img->top->height) {
-                    free(img->top);
-                    img->top = 0;
-                } else {
-                    rect++;
-                    data.packer.rects[rect].input.width = img->top->width;
-                    data.packer.rects[rect].input.height = img->top->height;
-                }
-            }
+        if (img->top && draw_datas[i].buffer) {
+            rect++;
+            data.packer.rects[rect].input.width = img->top->width;
+            data.packer.rects[rect].input.height = img->top->height;
         }
     }
 
@@ -427,15 +475,86 @@ static color_t to_32_bit(uint16_t c)
         ((c & 0x1f) << 3) | ((c & 0x1c) >> 2);
 }
 
+#if defined(USE_SSE2_CONVERSION)
+static void convert_pixel_block(const uint8_t *src, color_t *dst, int convert_transparent)
+{
+    __m128i colors = _mm_loadu_si128((const __m128i *) src);
+    __m128i zero = _mm_setzero_si128();
+    __m128i halves[2] = { _mm_unpacklo_epi16(colors, zero), _mm_unpackhi_epi16(colors, zero) };
+    for (int i = 0; i < 2; i++) {
+        __m128i c = halves[i];
+        __m128i red = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(c, _mm_set1_epi32(0x7c00)), 9),
+            _mm_slli_epi32(_mm_and_si128(c, _mm_set1_epi32(0x7000)), 4));
+        __m128i green = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(c, _mm_set1_epi32(0x3e0)), 6),
+            _mm_slli_epi32(_mm_and_si128(c, _mm_set1_epi32(0x380)), 1));
+        __m128i blue = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(c, _mm_set1_epi32(0x1f)), 3),
+            _mm_srli_epi32(_mm_and_si128(c, _mm_set1_epi32(0x1c)), 2));
+        __m128i result = _mm_or_si128(_mm_or_si128(red, green), _mm_or_si128(blue, _mm_set1_epi32((int) ALPHA_OPAQUE)));
+        if (convert_transparent) {
+            __m128i is_transparent = _mm_cmpeq_epi32(result, _mm_set1_epi32((int) COLOR_SG2_TRANSPARENT));
+            result = _mm_andnot_si128(is_transparent, result);
+        }
+        _mm_storeu_si128((__m128i *) &dst[i * 4], result);
+    }
+}
+#elif defined(USE_NEON_CONVERSION)
+static void convert_pixel_block(const uint8_t *src, color_t *dst, int convert_transparent)
+{
+    uint16x8_t colors = vld1q_u16((const uint16_t *) src);
+    uint32x4_t halves[2] = { vmovl_u16(vget_low_u16(colors)), vmovl_u16(vget_high_u16(colors)) };
+    for (int i = 0; i < 2; i++) {
+        uint32x4_t c = halves[i];
+        uint32x4_t red = vorrq_u32(vshlq_n_u32(vandq_u32(c, vdupq_n_u32(0x7c00)), 9),
+            vshlq_n_u32(vandq_u32(c, vdupq_n_u32(0x7000)), 4));
+        uint32x4_t green = vorrq_u32(vshlq_n_u32(vandq_u32(c, vdupq_n_u32(0x3e0)), 6),
+            vshlq_n_u32(vandq_u32(c, vdupq_n_u32(0x380)), 1));
+        uint32x4_t blue = vorrq_u32(vshlq_n_u32(vandq_u32(c, vdupq_n_u32(0x1f)), 3),
+            vshrq_n_u32(vandq_u32(c, vdupq_n_u32(0x1c)), 2));
+        uint32x4_t result = vorrq_u32(vorrq_u32(red, green), vorrq_u32(blue, vdupq_n_u32(ALPHA_OPAQUE)));
+        if (convert_transparent) {
+            result = vbicq_u32(result, vceqq_u32(result, vdupq_n_u32(COLOR_SG2_TRANSPARENT)));
+        }
+        vst1q_u32(&dst[i * 4], result);
+    }
+}
+#endif
+
+static void convert_pixels(const uint8_t *src, color_t *dst, int count, int convert_transparent)
+{
+    int i = 0;
+#if defined(USE_SSE2_CONVERSION) || defined(USE_NEON_CONVERSION)
+    for (; i + PIXEL_BLOCK_SIZE <= count; i += PIXEL_BLOCK_SIZE) {
+        convert_pixel_block(&src[i * 2], &dst[i], convert_transparent);
+    }
+#endif
+    for (; i < count; i++) {
+        color_t color = to_32_bit((uint16_t) (src[i * 2] | (src[i * 2 + 1] << 8)));
+        dst[i] = convert_transparent && color == COLOR_SG2_TRANSPARENT ? ALPHA_TRANSPARENT : color;
+    }
+}
+
+static void read_pixels(buffer *buf, color_t *dst, int count, int convert_transparent)
+{
+    int available = buf->index < buf->size ? (int) ((buf->size - buf->index) / 2) : 0;
+    int num_pixels = count < available ? count : available;
+    if (num_pixels > 0) {
+        convert_pixels(&buf->data[buf->index], dst, num_pixels, convert_transparent);
+        buffer_skip(buf, num_pixels * 2);
+    } else {
+        num_pixels = 0;
+    }
+    // Past the end of the buffer, read the same way as a single pixel read would
+    for (int i = num_pixels; i < count; i++) {
+        color_t color = to_32_bit(buffer_read_u16(buf));
+        dst[i] = convert_transparent && color == COLOR_SG2_TRANSPARENT ? ALPHA_TRANSPARENT : color;
+    }
+}
+
 static void convert_uncompressed(buffer *buf, int width, int height, int x_offset, int y_offset,
     color_t *dst, int dst_width)
 {
     for (int y = 0; y < height; y++) {
-        color_t *pixel = &dst[(y_offset + y) * dst_width + x_offset];
-        for (int x = 0; x < width; x++) {
-            color_t color = to_32_bit(buffer_read_u16(buf));
-            pixel[x] = color == COLOR_SG2_TRANSPARENT ? ALPHA_TRANSPARENT : color;
-        }
+        read_pixels(buf, &dst[(y_offset + y) * dst_width + x_offset], width, 1);
     }
 }
 
@@ -451,6 +570,9 @@ static void copy_compressed(const image *img, image_draw_data *draw_data, color_
 static void convert_compressed(buffer *buf, int width, int height, int x_offset, int y_offset,
     int buf_length, color_t *dst, int dst_width)
 {
+    if (width <= 0) {
+        return;
+    }
     int y = 0;
     int x = 0;
     while (buf_length > 0) {
@@ -469,10 +591,13 @@ static void convert_compressed(buffer *buf, int width, int height, int x_offset,
             }
             buf_length -= 2;
         } else {
-            // control = number of concrete pixels
-            for (int i = 0; i < control; i++) {
-                dst[(y + y_offset) * dst_width + x_offset + x] = to_32_bit(buffer_read_u16(buf));
-                x++;
+            // control = number of concrete pixels, which may continue on the next rows
+            int remaining = control;
+            while (remaining > 0) {
+                int pixels = width - x < remaining ? width - x : remaining;
+                read_pixels(buf, &dst[(y + y_offset) * dst_width + x_offset + x], pixels, 0);
+                remaining -= pixels;
+                x += pixels;
                 if (x >= width) {
                     y++;
                     if (y >= height) {
@@ -492,10 +617,8 @@ static void convert_footprint_tile(buffer *buf, const image *img,
     for (int y = 0; y < FOOTPRINT_HEIGHT; y++) {
         int x_start = FOOTPRINT_X_START_PER_HEIGHT[y];
         int x_max = FOOTPRINT_WIDTH - x_start;
-        for (int x = x_start; x < x_max; x++) {
-            dst[(y + y_offset + img->atlas.y_offset) * dst_width + img->atlas.x_offset + x + x_offset] =
-                to_32_bit(buffer_read_u16(buf));
-        }
+        color_t *pixel = &dst[(y + y_offset + img->atlas.y_offset) * dst_width + img->atlas.x_offset + x_offset];
+        read_pixels(buf, &pixel[x_start], x_max - x_start, 0);
     }
 }
 
@@ -522,20 +645,22 @@ static void convert_isometric_footprint(buffer *buf, const image *img, color_t *
     }
 }
 
-static void convert_images(image *images, image_draw_data *draw_datas, int size, buffer *buf,
-    const image_atlas_data *atlas_data)
+static void convert_images_job(int part, int first, int last, void *userdata)
 {
-    for (int i = 0; i < size; i++) {
-        image *img = &images[i];
-        image_draw_data *draw_data = &draw_datas[i];
+    const image_job *job = userdata;
+    const image_atlas_data *atlas_data = job->atlas_data;
+    buffer buf = *job->buf;
+    for (int i = first; i < last; i++) {
+        image *img = &job->images[i];
+        image_draw_data *draw_data = &job->draw_datas[i];
         if (image_is_external(img)) {
             continue;
         }
         // Don't load original placeholder images
-        if (atlas_data->type == ATLAS_MAIN && i >= 6145 && i <= 6192) {
+        if (is_placeholder_image(atlas_data->type, i)) {
             continue;
         }
-        buffer_set(buf, draw_data->offset);
+        buffer_set(&buf, draw_data->offset);
         color_t *dst = atlas_data->buffers[img->atlas.id & IMAGE_ATLAS_BIT_MASK];
         int dst_width = atlas_data->image_widths[img->atlas.id & IMAGE_ATLAS_BIT_MASK];
         if (draw_data->is_compressed) {
@@ -544,23 +669,31 @@ static void convert_images(image *images, image_draw_data *draw_datas, int size,
                 free(draw_data->buffer);
                 draw_data->buffer = 0;
             } else {
-                convert_compressed(buf, img->width, img->height, img->atlas.x_offset, img->atlas.y_offset,
+                convert_compressed(&buf, img->width, img->height, img->atlas.x_offset, img->atlas.y_offset,
                     draw_data->data_length, dst, dst_width);
             }
         } else if (img->is_isometric) {
-            convert_isometric_footprint(buf, img, dst, dst_width);
+            convert_isometric_footprint(&buf, img, dst, dst_width);
             if (img->top) {
                 color_t *dst_top = atlas_data->buffers[img->top->atlas.id & IMAGE_ATLAS_BIT_MASK];
                 int dst_width_top = atlas_data->image_widths[img->top->atlas.id & IMAGE_ATLAS_BIT_MASK];
                 copy_compressed(img->top, draw_data, dst_top, dst_width_top);
             }
         } else {
-            convert_uncompressed(buf, img->width, img->height, img->atlas.x_offset, img->atlas.y_offset,
+            convert_uncompressed(&buf, img->width, img->height, img->atlas.x_offset, img->atlas.y_offset,
                 dst, dst_width);
         }
     }
 }
 
+static void convert_images(image *images, image_draw_data *draw_datas, int size, buffer *buf,
+    const image_atlas_data *atlas_data)
+{
+    // Every image is written to its own rectangle of the atlas
+    image_job job = { buf, images, draw_datas, atlas_data, atlas_data->type };
+    jobs_run(size, MIN_IMAGES_PER_JOB_PART, convert_images_job, &job);
+}
+
 static void make_font_white(const image *img, const image_atlas_data *atlas_data)
 {
     color_t *pixels = atlas_data->buffers[img->atlas.id & IMAGE_ATLAS_BIT_MASK];
@@ -619,6 +752,7 @@ int image_load_climate(int climate_id, int is_editor, int force_reload, int keep
         graphics_renderer()->has_image_atlas(ATLAS_MAIN)) {
         return 1;
     }
+    uint64_t start_time = system_get_ticks();
     graphics_renderer()->get_max_image_size(&data.max_image_width, &data.max_image_height);
 
     for (int i = 0; i < IMAGE_MAIN_ENTRIES; i++) {
@@ -692,7 +826,7 @@ int image_load_climate(int climate_id, int is_editor, int force_reload, int keep
     free(tmp_data);
     make_plain_fonts_white(data.main, atlas_data, image_group(GROUP_FONT));
     if (!keep_atlas_buffers) {
-        assets_init(data.is_editor != is_editor, atlas_data->buffers, atlas_data->image_widths);
+        assets_init(data.is_editor != is_editor, filename_bmp, atlas_data->buffers, atlas_data->image_widths);
     }
     graphics_renderer()->create_image_atlas(atlas_data, !keep_atlas_buffers);
     image_packer_free(&data.packer);
@@ -713,6 +847,8 @@ int image_load_climate(int climate_id, int is_editor, int force_reload, int keep
 
     data.images_with_tops = 0;
 
+    log_info("Climate images loaded, time in ms:", 0, (int) (system_get_ticks() - start_time));
+
     return 1;
 }
 
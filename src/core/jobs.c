@@ -0,0 +1,171 @@
+#include "jobs.h"
+
+#include "core/log.h"
+#include "platform/thread.h"
+
+#include <stdint.h>
+
+#define MAX_WORKERS (JOBS_MAX_PARTS - 1)
+
+static struct {
+    int workers_started;
+    int num_workers;
+    int quit;
+    int is_running;
+    platform_thread *workers[MAX_WORKERS];
+    platform_mutex *mutex;
+    platform_semaphore *start;
+    platform_semaphore *done;
+    struct {
+        jobs_function function;
+        void *userdata;
+        int num_items;
+        int num_parts;
+        int next_part;
+    } job;
+} data;
+
+int jobs_num_parts(int num_items, int min_items_per_part)
+{
+    if (min_items_per_part < 1) {
+        min_items_per_part = 1;
+    }
+    int num_parts = num_items / min_items_per_part;
+    if (num_parts > JOBS_MAX_PARTS) {
+        return JOBS_MAX_PARTS;
+    }
+    return num_parts > 1 ? num_parts : 1;
+}
+
+static int next_part(void)
+{
+    platform_mutex_lock(data.mutex);
+    int part = data.job.next_part < data.job.num_parts ? data.job.next_part++ : -1;
+    platform_mutex_unlock(data.mutex);
+    return part;
+}
+
+static void run_part(jobs_function function, int num_items, int num_parts, int part, void *userdata)
+{
+    int first = (int) ((int64_t) num_items * part / num_parts);
+    int last = (int) ((int64_t) num_items * (part + 1) / num_parts);
+    function(part, first, last, userdata);
+}
+
+static void run_parts(void)
+{
+    int part;
+    while ((part = next_part()) >= 0) {
+        run_part(data.job.function, data.job.num_items, data.job.num_parts, part, data.job.userdata);
+    }
+}
+
+static int worker(void *unused)
+{
+    while (1) {
+        platform_semaphore_wait(data.start);
+        if (data.quit) {
+            break;
+        }
+        run_parts();
+        platform_semaphore_post(data.done);
+    }
+    return 0;
+}
+
+static void destroy_sync_objects(void)
+{
+    if (data.mutex) {
+        platform_mutex_destroy(data.mutex);
+        data.mutex = 0;
+    }
+    if (data.start) {
+        platform_semaphore_destroy(data.start);
+        data.start = 0;
+    }
+    if (data.done) {
+        platform_semaphore_destroy(data.done);
+        data.done = 0;
+    }
+}
+
+static void start_workers(void)
+{
+    data.workers_started = 1;
+    int num_workers = platform_thread_cpu_count() - 1;
+    if (num_workers > MAX_WORKERS) {
+        num_workers = MAX_WORKERS;
+    }
+    if (num_workers <= 0) {
+        return;
+    }
+    data.mutex = platform_mutex_create();
+    data.start = platform_semaphore_create(0);
+    data.done = platform_semaphore_create(0);
+    if (!data.mutex || !data.start || !data.done) {
+        log_error("Unable to create job synchronization, jobs will run on the main thread", 0, 0);
+        destroy_sync_objects();
+        return;
+    }
+    data.quit = 0;
+    for (int i = 0; i < num_workers; i++) {
+        data.workers[data.num_workers] = platform_thread_create(worker, "job worker", 0);
+        if (!data.workers[data.num_workers]) {
+            break;
+        }
+        data.num_workers++;
+    }
+    if (!data.num_workers) {
+        destroy_sync_objects();
+        return;
+    }
+    log_info("Job workers started:", 0, data.num_workers);
+}
+
+int jobs_run(int num_items, int min_items_per_part, jobs_function function, void *userdata)
+{
+    int num_parts = jobs_num_parts(num_items, min_items_per_part);
+    if (num_parts > 1 && !data.workers_started) {
+        start_workers();
+    }
+    if (num_parts == 1 || !data.num_workers || data.is_running) {
+        // Also covers a job started from within another job, which would otherwise wait for itself
+        for (int part = 0; part < num_parts; part++) {
+            run_part(function, num_items, num_parts, part, userdata);
+        }
+        return num_parts;
+    }
+    data.is_running = 1;
+    data.job.function = function;
+    data.job.userdata = userdata;
+    data.job.num_items = num_items;
+    data.job.num_parts = num_parts;
+    data.job.next_part = 0;
+
+    int workers_to_wake = num_parts - 1 < data.num_workers ? num_parts - 1 : data.num_workers;
+    for (int i = 0; i < workers_to_wake; i++) {
+        platform_semaphore_post(data.start);
+    }
+    run_parts();
+    for (int i = 0; i < workers_to_wake; i++) {
+        platform_semaphore_wait(data.done);
+    }
+    data.is_running = 0;
+    return num_parts;
+}
+
+void jobs_shutdown(void)
+{
+    if (data.num_workers) {
+        data.quit = 1;
+        for (int i = 0; i < data.num_workers; i++) {
+            platform_semaphore_post(data.start);
+        }
+        for (int i = 0; i < data.num_workers; i++) {
+            platform_thread_wait(data.workers[i]);
+        }
+        data.num_workers = 0;
+        destroy_sync_objects();
+    }
+    data.workers_started = 0;
+}
@@ -0,0 +1,49 @@
+#ifndef CORE_JOBS_H
+#define CORE_JOBS_H
+
+/**
+ * @file
+ * Runs independent parts of a calculation on worker threads.
+ *
+ * The items of a job are split into consecutive parts. How the items are split only depends on the number of items
+ * and the minimum part size, never on the number of threads or on which thread runs first, so results that are
+ * kept per part and merged in part order are the same as when running the whole job on one thread.
+ */
+
+#define JOBS_MAX_PARTS 16
+
+/**
+ * Function that processes one part of a job
+ * @param part The part number, from 0 to the number of parts - 1. Use it to index per-part results.
+ * @param first The first item of the part
+ * @param last One past the last item of the part
+ * @param userdata The userdata passed to jobs_run
+ */
+typedef void (*jobs_function)(int part, int first, int last, void *userdata);
+
+/**
+ * Gets the number of parts that jobs_run will split the items into
+ * @param num_items The number of items
+ * @param min_items_per_part The minimum number of items to make running a part on another thread worthwhile
+ * @return The number of parts, from 1 to JOBS_MAX_PARTS
+ */
+int jobs_num_parts(int num_items, int min_items_per_part);
+
+/**
+ * Runs a job on the worker threads and on the calling thread, returning when all parts are done.
+ * Parts may run in any order and at the same time, so they may only write to their own items and per-part results.
+ * If threads are not available, all parts run on the calling thread.
+ * @param num_items The number of items
+ * @param min_items_per_part The minimum number of items to make running a part on another thread worthwhile
+ * @param function The function to run for each part
+ * @param userdata Data to pass to the function
+ * @return The number of parts the items were split into
+ */
+int jobs_run(int num_items, int min_items_per_part, jobs_function function, void *userdata);
+
+/**
+ * Stops the worker threads. They are started again by the next job.
+ */
+void jobs_shutdown(void);
+
+#endif // CORE_JOBS_H
@@ -6,6 +6,7 @@
 #include "core/io.h"
 #include "core/log.h"
 #include "core/string.h"
+#include "figure/type.h"
 #include "translation/translation.h"
 
 #include <stdlib.h>
@@ -32,6 +33,14 @@
 #define FILE_EDITOR_TEXT_RUS "c3_map.rus"
 #define FILE_EDITOR_MM_RUS "c3_map_mm.rus"
 
+// Starting with FIGURE_WORK_CAMP_WORKER = 73,
+static const translation_key NEW_FIGURE_TYPES[] = {
+    TR_FIGURE_TYPE_WORK_CAMP_WORKER,TR_FIGURE_TYPE_WORK_CAMP_SLAVE,TR_FIGURE_TYPE_WORK_CAMP_ARCHITECT,TR_FIGURE_TYPE_MESS_HALL_SUPPLIER,TR_FIGURE_TYPE_MESS_HALL_COLLECTOR,
+    TR_FIGURE_TYPE_PRIEST_SUPPLIER, TR_FIGURE_TYPE_BARKEEP, TR_FIGURE_TYPE_BARKEEP_SUPPLIER, TR_FIGURE_TYPE_TOURIST, TR_FIGURE_TYPE_WATCHMAN, 0, 0, TR_FIGURE_TYPE_CARAVANSERAI_SUPPLIER,
+    TR_FIGURE_TYPE_ROBBER, TR_FIGURE_TYPE_LOOTER, TR_FIGURE_TYPE_CARAVANSERAI_COLLECTOR, TR_FIGURE_TYPE_LIGHTHOUSE_SUPPLIER, TR_FIGURE_TYPE_MESS_HALL_COLLECTOR, 0, 0, TR_FIGURE_TYPE_BEGGAR,
+    0, TR_FIGURE_ENEMY_CATAPULT, 0
+};
+
 static struct {
     struct {
         int32_t offset;
@@ -608,6 +617,18 @@ const uint8_t *lang_get_building_type_string(int type)
     }
 }
 
+const uint8_t *lang_get_figure_type_string(int type)
+{
+    static const uint8_t EMPTY_STRING[] = { 0 };
+    if (type < FIGURE_NEW_TYPES) {
+        return lang_get_string(64, type);
+    }
+    if (type >= FIGURE_TYPE_MAX || !NEW_FIGURE_TYPES[type - FIGURE_NEW_TYPES]) {
+        return EMPTY_STRING;
+    }
+    return translation_for(NEW_FIGURE_TYPES[type - FIGURE_NEW_TYPES]);
+}
+
 const lang_message *lang_get_message(int id)
 {
     return &data.message_entries[id];
@@ -101,6 +101,13 @@ const uint8_t *lang_get_string(int group, int index);
  */
 const uint8_t *lang_get_building_type_string(int type);
 
+/**
+ * Gets a localized string for a figure type
+ * @param type The figure type to get the display string of
+ * @return String, empty if the figure type has no name
+ */
+const uint8_t *lang_get_figure_type_string(int type);
+
 /**
  * Gets the message for the specified ID
  * @param id ID of the message
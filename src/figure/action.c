@@ -3,6 +3,7 @@
 #include "city/entertainment.h"
 #include "city/figures.h"
 #include "figure/figure.h"
+#include "game/tick_profiler.h"
 #include "figuretype/animal.h"
 #include "figuretype/cartpusher.h"
 #include "figuretype/crime.h"
@@ -143,10 +144,14 @@ void figure_action_handle(void)
                     f->targeted_by_figure_id = 0;
                 }
             }
+            figure_type type = f->type;
+            uint64_t start = tick_profiler_start();
             figure_action_callbacks[f->type](f);
+            tick_profiler_accumulate(TICK_PROFILER_FIGURE, type, start);
             if (f->state == FIGURE_STATE_DEAD) {
                 figure_delete(f);
             }
         }
     }
+    tick_profiler_commit(TICK_PROFILER_FIGURE);
 }
@@ -12,6 +12,9 @@
 #include "map/figure.h"
 #include "sound/effect.h"
 
+#define ENEMY_TARGET_SEARCH_STEP 8
+#define ENEMY_TARGET_MAX_SEARCH_RADIUS 24
+
 static int is_attacking_native(const figure *f)
 {
     return f->type == FIGURE_INDIGENOUS_NATIVE && f->action_state == FIGURE_ACTION_159_NATIVE_ATTACKING;
@@ -47,18 +50,19 @@ static int attack_is_same_direction(int dir1, int dir2)
 
 static void resume_activity_after_attack(figure *f)
 {
-    f->num_attackers = 0;
+    figure_extra *extra = figure_extra_get(f->id);
+    extra->num_attackers = 0;
     f->action_state = f->action_state_before_attack;
-    f->opponent_id = 0;
-    f->attacker_id1 = 0;
-    f->attacker_id2 = 0;
+    extra->opponent_id = 0;
+    extra->attacker_id1 = 0;
+    extra->attacker_id2 = 0;
     figure_route_remove(f);
 }
 
 static void hit_opponent(figure *f)
 {
     const formation *m = formation_get(f->formation_id);
-    figure *opponent = figure_get(f->opponent_id);
+    figure *opponent = figure_get(figure_extra_get(f->id)->opponent_id);
     formation *opponent_formation = formation_get(opponent->formation_id);
 
     const figure_properties *props = figure_properties_for_type(f->type);
@@ -76,7 +80,7 @@ static void hit_opponent(figure *f)
     if (f->type == FIGURE_WOLF) {
         figure_attack = difficulty_adjust_wolf_attack(figure_attack);
     }
-    if (opponent->opponent_id != f->id && m->figure_type != FIGURE_FORT_LEGIONARY &&
+    if (figure_extra_get(opponent->id)->opponent_id != f->id && m->figure_type != FIGURE_FORT_LEGIONARY &&
             attack_is_same_direction(f->attack_direction, opponent->attack_direction)) {
         figure_attack += 4; // attack opponent on the (exposed) back
         sound_effect_play(SOUND_EFFECT_SWORD_SWING);
@@ -143,31 +147,32 @@ static void hit_opponent(figure *f)
 
 void figure_combat_handle_attack(figure *f)
 {
+    figure_extra *extra = figure_extra_get(f->id);
     figure_movement_advance_attack(f);
-    if (f->num_attackers == 0) {
+    if (extra->num_attackers == 0) {
         resume_activity_after_attack(f);
         return;
     }
-    if (f->num_attackers == 1) {
-        figure *target = figure_get(f->opponent_id);
+    if (extra->num_attackers == 1) {
+        figure *target = figure_get(extra->opponent_id);
         if (figure_is_dead(target)) {
             resume_activity_after_attack(f);
             return;
         }
-    } else if (f->num_attackers == 2) {
-        if (figure_is_dead(figure_get(f->opponent_id))) {
-            if (f->opponent_id == f->attacker_id1) {
-                f->opponent_id = f->attacker_id2;
-            } else if (f->opponent_id == f->attacker_id2) {
-                f->opponent_id = f->attacker_id1;
+    } else if (extra->num_attackers == 2) {
+        if (figure_is_dead(figure_get(extra->opponent_id))) {
+            if (extra->opponent_id == extra->attacker_id1) {
+                extra->opponent_id = extra->attacker_id2;
+            } else if (extra->opponent_id == extra->attacker_id2) {
+                extra->opponent_id = extra->attacker_id1;
             }
-            if (figure_is_dead(figure_get(f->opponent_id))) {
+            if (figure_is_dead(figure_get(extra->opponent_id))) {
                 resume_activity_after_attack(f);
                 return;
             }
-            f->num_attackers = 1;
-            f->attacker_id1 = f->opponent_id;
-            f->attacker_id2 = 0;
+            extra->num_attackers = 1;
+            extra->attacker_id1 = extra->opponent_id;
+            extra->attacker_id2 = 0;
         }
     }
     f->attack_image_offset++;
@@ -176,31 +181,61 @@ void figure_combat_handle_attack(figure *f)
     }
 }
 
-int figure_combat_get_target_for_soldier(int x, int y, int max_distance)
+static struct {
+    int x;
+    int y;
+    int max_distance;
+    int min_distance;
+    int min_figure_id;
+} search;
+
+static void start_search(int x, int y, int max_distance)
 {
-    int min_figure_id = 0;
-    int min_distance = 10000;
-    for (int i = 1; i < figure_count(); i++) {
-        figure *f = figure_get(i);
-        if (figure_is_dead(f) || f->is_ghost ) {
-            // Do not allow to target dead and enemies located outside of the map
-            continue;
-        }
-        if (figure_is_enemy(f) || f->type == FIGURE_RIOTER || is_attacking_native(f)) {
-            int distance = calc_maximum_distance(x, y, f->x, f->y);
-            if (distance <= max_distance) {
-                if (f->targeted_by_figure_id) {
-                    distance *= 2; // penalty
-                }
-                if (distance < min_distance) {
-                    min_distance = distance;
-                    min_figure_id = i;
-                }
+    search.x = x;
+    search.y = y;
+    search.max_distance = max_distance;
+    search.min_distance = 10000;
+    search.min_figure_id = 0;
+}
+
+// Figures are visited by location instead of by id, so ties on distance go to the lowest id
+// to give the same result as a scan over all figures
+static void consider_target(const figure *f, int distance)
+{
+    if (distance < search.min_distance || (distance == search.min_distance && f->id < search.min_figure_id)) {
+        search.min_distance = distance;
+        search.min_figure_id = f->id;
+    }
+}
+
+static void search_area(int radius, void (*callback)(figure *f))
+{
+    map_figure_foreach_in_area(search.x - radius, search.y - radius, search.x + radius, search.y + radius, callback);
+}
+
+static void consider_target_for_soldier(figure *f)
+{
+    if (figure_is_dead(f) || f->is_ghost) {
+        // Do not allow to target dead and enemies located outside of the map
+        return;
+    }
+    if (figure_is_enemy(f) || f->type == FIGURE_RIOTER || is_attacking_native(f)) {
+        int distance = calc_maximum_distance(search.x, search.y, f->x, f->y);
+        if (distance <= search.max_distance) {
+            if (f->targeted_by_figure_id) {
+                distance *= 2; // penalty
             }
+            consider_target(f, distance);
         }
     }
-    if (min_figure_id) {
-        return min_figure_id;
+}
+
+int figure_combat_get_target_for_soldier(int x, int y, int max_distance)
+{
+    start_search(x, y, max_distance);
+    search_area(max_distance, consider_target_for_soldier);
+    if (search.min_figure_id) {
+        return search.min_figure_id;
     }
     for (int i = 1; i < figure_count(); i++) {
         figure *f = figure_get(i);
@@ -214,60 +249,86 @@ int figure_combat_get_target_for_soldier(int x, int y, int max_distance)
     return 0;
 }
 
+static void consider_target_for_wolf(figure *f)
+{
+    if (figure_is_dead(f) || !f->type) {
+        return;
+    }
+    switch (f->type) {
+        case FIGURE_EXPLOSION:
+        case FIGURE_FORT_STANDARD:
+        case FIGURE_TRADE_SHIP:
+        case FIGURE_FISHING_BOAT:
+        case FIGURE_MAP_FLAG:
+        case FIGURE_FLOTSAM:
+        case FIGURE_SHIPWRECK:
+        case FIGURE_INDIGENOUS_NATIVE:
+        case FIGURE_TOWER_SENTRY:
+        case FIGURE_NATIVE_TRADER:
+        case FIGURE_ARROW:
+        case FIGURE_JAVELIN:
+        case FIGURE_BOLT:
+        case FIGURE_BALLISTA:
+        case FIGURE_CATAPULT_MISSILE:
+        case FIGURE_FRIENDLY_ARROW:
+        case FIGURE_WATCHTOWER_ARCHER:
+        case FIGURE_CREATURE:
+            return;
+    }
+    if (figure_is_herd(f)) {
+        return;
+    }
+    if (figure_is_legion(f) && f->action_state == FIGURE_ACTION_80_SOLDIER_AT_REST) {
+        return;
+    }
+    int distance = calc_maximum_distance(search.x, search.y, f->x, f->y);
+    if (f->targeted_by_figure_id) {
+        distance *= 2;
+    }
+    consider_target(f, distance);
+}
+
 int figure_combat_get_target_for_wolf(int x, int y, int max_distance)
 {
-    int min_figure_id = 0;
-    int min_distance = 10000;
-    for (int i = 1; i < figure_count(); i++) {
-        figure *f = figure_get(i);
-        if (figure_is_dead(f) || !f->type) {
-            continue;
-        }
-        switch (f->type) {
-            case FIGURE_EXPLOSION:
-            case FIGURE_FORT_STANDARD:
-            case FIGURE_TRADE_SHIP:
-            case FIGURE_FISHING_BOAT:
-            case FIGURE_MAP_FLAG:
-            case FIGURE_FLOTSAM:
-            case FIGURE_SHIPWRECK:
-            case FIGURE_INDIGENOUS_NATIVE:
-            case FIGURE_TOWER_SENTRY:
-            case FIGURE_NATIVE_TRADER:
-            case FIGURE_ARROW:
-            case FIGURE_JAVELIN:
-            case FIGURE_BOLT:
-            case FIGURE_BALLISTA:
-            case FIGURE_CATAPULT_MISSILE:
-            case FIGURE_FRIENDLY_ARROW:
-            case FIGURE_WATCHTOWER_ARCHER:
-            case FIGURE_CREATURE:
-                continue;
-        }
-        if (figure_is_herd(f)) {
-            continue;
-        }
-        if (figure_is_legion(f) && f->action_state == FIGURE_ACTION_80_SOLDIER_AT_REST) {
-            continue;
-        }
-        int distance = calc_maximum_distance(x, y, f->x, f->y);
-        if (f->targeted_by_figure_id) {
-            distance *= 2;
-        }
-        if (distance < min_distance) {
-            min_distance = distance;
-            min_figure_id = i;
-        }
+    // the penalty only increases the distance, so any valid target is within max_distance
+    start_search(x, y, max_distance);
+    search_area(max_distance, consider_target_for_wolf);
+    if (search.min_distance <= max_distance && search.min_figure_id) {
+        return search.min_figure_id;
     }
-    if (min_distance <= max_distance && min_figure_id) {
-        return min_figure_id;
+    return 0;
+}
+
+static void consider_target_for_enemy(figure *f)
+{
+    if (figure_is_dead(f)) {
+        return;
+    }
+    if (!f->targeted_by_figure_id && figure_is_legion(f)) {
+        consider_target(f, calc_maximum_distance(search.x, search.y, f->x, f->y));
+    }
+}
+
+static int get_nearby_target_for_enemy(int x, int y)
+{
+    for (int radius = ENEMY_TARGET_SEARCH_STEP; radius <= ENEMY_TARGET_MAX_SEARCH_RADIUS;
+        radius += ENEMY_TARGET_SEARCH_STEP) {
+        start_search(x, y, radius);
+        search_area(radius, consider_target_for_enemy);
+        if (search.min_figure_id && search.min_distance <= radius) {
+            // no figure outside of the searched area can be closer
+            return search.min_figure_id;
+        }
     }
     return 0;
 }
 
 int figure_combat_get_target_for_enemy(int x, int y)
 {
-    int min_figure_id = 0;
+    int min_figure_id = get_nearby_target_for_enemy(x, y);
+    if (min_figure_id) {
+        return min_figure_id;
+    }
     int min_distance = 10000;
     for (int i = 1; i < figure_count(); i++) {
         figure *f = figure_get(i);
@@ -479,15 +540,17 @@ void figure_combat_attack_figure_at(figure *f, int grid_offset)
         } else if (can_attack_animal(category, opponent_category, l, opponent)) {
             attack = 1;
         }
-        if (attack && opponent->action_state == FIGURE_ACTION_150_ATTACK && opponent->num_attackers >= 2) {
+        figure_extra *opponent_extra = figure_extra_get(opponent->id);
+        if (attack && opponent->action_state == FIGURE_ACTION_150_ATTACK && opponent_extra->num_attackers >= 2) {
             attack = 0;
         }
         if (attack) {
+            figure_extra *extra = figure_extra_get(f->id);
             f->action_state_before_attack = f->action_state;
             f->action_state = FIGURE_ACTION_150_ATTACK;
-            f->opponent_id = opponent_id;
-            f->attacker_id1 = opponent_id;
-            f->num_attackers = 1;
+            extra->opponent_id = opponent_id;
+            extra->attacker_id1 = opponent_id;
+            extra->num_attackers = 1;
             f->attack_image_offset = 12;
             if (opponent->x != opponent->destination_x || opponent->y != opponent->destination_y) {
                 f->attack_direction = calc_general_direction(f->previous_tile_x, f->previous_tile_y,
@@ -505,13 +568,13 @@ void figure_combat_attack_figure_at(figure *f, int grid_offset)
                 opponent->attack_image_offset = 0;
                 opponent->attack_direction = (f->attack_direction + 4) % 8;
             }
-            if (opponent->num_attackers == 0) {
-                opponent->attacker_id1 = f->id;
-                opponent->opponent_id = f->id;
-                opponent->num_attackers = 1;
-            } else if (opponent->num_attackers == 1) {
-                opponent->attacker_id2 = f->id;
-                opponent->num_attackers = 2;
+            if (opponent_extra->num_attackers == 0) {
+                opponent_extra->attacker_id1 = f->id;
+                opponent_extra->opponent_id = f->id;
+                opponent_extra->num_attackers = 1;
+            } else if (opponent_extra->num_attackers == 1) {
+                opponent_extra->attacker_id2 = f->id;
+                opponent_extra->num_attackers = 2;
             }
             return;
         }
@@ -24,6 +24,7 @@
 static struct {
     int created_sequence;
     array(figure) figures;
+    array(figure_extra) extras;
 } data;
 
 figure *figure_get(int id)
@@ -31,6 +32,24 @@ figure *figure_get(int id)
     return array_item(data.figures, id);
 }
 
+figure_extra *figure_extra_get(int id)
+{
+    return array_item(data.extras, id);
+}
+
+static figure_extra *create_extra(int id)
+{
+    // The extras array is never trimmed, so it always has an item for every figure id
+    while (data.extras.size <= (unsigned int) id) {
+        if (!array_advance(data.extras)) {
+            return 0;
+        }
+    }
+    figure_extra *extra = array_item(data.extras, id);
+    memset(extra, 0, sizeof(figure_extra));
+    return extra;
+}
+
 int figure_count(void)
 {
     return data.figures.size;
@@ -43,6 +62,11 @@ figure *figure_create(figure_type type, int x, int y, direction_type dir)
     if (!f) {
         return array_first(data.figures);
     }
+    figure_extra *extra = create_extra(f->id);
+    if (!extra) {
+        array_trim(data.figures);
+        return array_first(data.figures);
+    }
 
     f->state = FIGURE_STATE_ALIVE;
     f->faction_id = 1;
@@ -64,11 +88,11 @@ figure *figure_create(figure_type type, int x, int y, direction_type dir)
     f->destination_building_id = 0;
     f->wait_ticks = 0;
     random_generate_next();
-    f->phrase_sequence_city = f->phrase_sequence_exact = random_byte() & 3;
+    extra->phrase_sequence_city = extra->phrase_sequence_exact = random_byte() & 3;
     f->name = figure_name_get(type, 0);
     map_figure_add(f);
     if (type == FIGURE_TRADE_CARAVAN || type == FIGURE_TRADE_SHIP) {
-        f->trader_id = trader_create();
+        extra->trader_id = trader_create();
     }
     return f;
 }
@@ -190,8 +214,9 @@ void figure_delete(figure *f)
             }
             break;
     }
-    if (f->empire_city_id) {
-        empire_city_remove_trader(f->empire_city_id, f->id);
+    figure_extra *extra = figure_extra_get(f->id);
+    if (extra->empire_city_id) {
+        empire_city_remove_trader(extra->empire_city_id, f->id);
     }
     if (f->immigrant_building_id) {
         building_get(f->immigrant_building_id)->immigrant_figure_id = 0;
@@ -202,8 +227,10 @@ void figure_delete(figure *f)
 
     int figure_id = f->id;
     memset(f, 0, sizeof(figure));
+    memset(extra, 0, sizeof(figure_extra));
     f->id = figure_id;
 
+    array_item_freed(data.figures, figure_id);
     array_trim(data.figures);
 }
 
@@ -240,9 +267,11 @@ static int figure_is_active(const figure *f)
 void figure_init_scenario(void)
 {
     if (!array_init(data.figures, FIGURE_ARRAY_SIZE_STEP, initialize_new_figure, figure_is_active) ||
-        !array_next(data.figures)) { // Ignore first figure
+        !array_next(data.figures) || // Ignore first figure
+        !array_init(data.extras, FIGURE_ARRAY_SIZE_STEP, 0, 0) || !array_next(data.extras)) {
         log_error("Unable to create figures array. The game will now crash.", 0, 0);
     }
+    array_track_free_slots(data.figures);
     data.created_sequence = 0;
 }
 
@@ -278,6 +307,7 @@ int figure_target_is_alive(const figure *f)
 
 static void figure_save(buffer *buf, const figure *f)
 {
+    const figure_extra *extra = figure_extra_get(f->id);
     buffer_write_u8(buf, f->alternative_location_index);
     buffer_write_u8(buf, f->image_offset);
     buffer_write_u8(buf, f->is_enemy_image);
@@ -348,8 +378,8 @@ static void figure_save(buffer *buf, const figure *f)
     buffer_write_u8(buf, f->wait_ticks_missile);
     buffer_write_i8(buf, f->x_offset_cart);
     buffer_write_i8(buf, f->y_offset_cart);
-    buffer_write_u8(buf, f->empire_city_id);
-    buffer_write_u8(buf, f->trader_amount_bought);
+    buffer_write_u8(buf, extra->empire_city_id);
+    buffer_write_u8(buf, extra->trader_amount_bought);
     buffer_write_i16(buf, f->name);
     buffer_write_u8(buf, f->terrain_usage);
     buffer_write_u8(buf, f->loads_sold_or_carrying);
@@ -358,11 +388,11 @@ static void figure_save(buffer *buf, const figure *f)
     buffer_write_u8(buf, f->current_height);
     buffer_write_u8(buf, f->target_height);
     buffer_write_u8(buf, f->collecting_item_id);
-    buffer_write_u8(buf, f->trade_ship_failed_dock_attempts);
-    buffer_write_u8(buf, f->phrase_sequence_exact);
-    buffer_write_i8(buf, f->phrase_id);
-    buffer_write_u8(buf, f->phrase_sequence_city);
-    buffer_write_u8(buf, f->trader_id);
+    buffer_write_u8(buf, extra->trade_ship_failed_dock_attempts);
+    buffer_write_u8(buf, extra->phrase_sequence_exact);
+    buffer_write_i8(buf, extra->phrase_id);
+    buffer_write_u8(buf, extra->phrase_sequence_city);
+    buffer_write_u8(buf, extra->trader_id);
     buffer_write_u8(buf, f->wait_ticks_next_target);
     buffer_write_u8(buf, f->dont_draw_elevated);
     buffer_write_i16(buf, f->target_figure_id);
@@ -370,10 +400,10 @@ static void figure_save(buffer *buf, const figure *f)
     buffer_write_u16(buf, f->created_sequence);
     buffer_write_u16(buf, f->target_figure_created_sequence);
     buffer_write_u8(buf, f->figures_on_same_tile_index);
-    buffer_write_u8(buf, f->num_attackers);
-    buffer_write_i16(buf, f->attacker_id1);
-    buffer_write_i16(buf, f->attacker_id2);
-    buffer_write_i16(buf, f->opponent_id);
+    buffer_write_u8(buf, extra->num_attackers);
+    buffer_write_i16(buf, extra->attacker_id1);
+    buffer_write_i16(buf, extra->attacker_id2);
+    buffer_write_i16(buf, extra->opponent_id);
     buffer_write_i16(buf, f->last_visited_index);
 }
 
@@ -396,7 +426,7 @@ static int get_resource_id(figure_type type, int resource)
     }
 }
 
-static void figure_load(buffer *buf, figure *f, int figure_buf_size, int version)
+static void figure_load(buffer *buf, figure *f, figure_extra *extra, int figure_buf_size, int version)
 {
     f->alternative_location_index = buffer_read_u8(buf);
     f->image_offset = buffer_read_u8(buf);
@@ -473,8 +503,8 @@ static void figure_load(buffer *buf, figure *f, int figure_buf_size, int version
     f->wait_ticks_missile = buffer_read_u8(buf);
     f->x_offset_cart = buffer_read_i8(buf);
     f->y_offset_cart = buffer_read_i8(buf);
-    f->empire_city_id = buffer_read_u8(buf);
-    f->trader_amount_bought = buffer_read_u8(buf);
+    extra->empire_city_id = buffer_read_u8(buf);
+    extra->trader_amount_bought = buffer_read_u8(buf);
     f->name = buffer_read_i16(buf);
     f->terrain_usage = buffer_read_u8(buf);
     f->loads_sold_or_carrying = buffer_read_u8(buf);
@@ -484,11 +514,11 @@ static void figure_load(buffer *buf, figure *f, int figure_buf_size, int version
     f->target_height = buffer_read_u8(buf);
     f->collecting_item_id = (version <= SAVE_GAME_LAST_STATIC_RESOURCES) ?
         get_resource_id(f->type, buffer_read_u8(buf)) : resource_remap(buffer_read_u8(buf));
-    f->trade_ship_failed_dock_attempts = buffer_read_u8(buf);
-    f->phrase_sequence_exact = buffer_read_u8(buf);
-    f->phrase_id = buffer_read_i8(buf);
-    f->phrase_sequence_city = buffer_read_u8(buf);
-    f->trader_id = buffer_read_u8(buf);
+    extra->trade_ship_failed_dock_attempts = buffer_read_u8(buf);
+    extra->phrase_sequence_exact = buffer_read_u8(buf);
+    extra->phrase_id = buffer_read_i8(buf);
+    extra->phrase_sequence_city = buffer_read_u8(buf);
+    extra->trader_id = buffer_read_u8(buf);
     f->wait_ticks_next_target = buffer_read_u8(buf);
     f->dont_draw_elevated = buffer_read_u8(buf);
     f->target_figure_id = buffer_read_i16(buf);
@@ -496,10 +526,10 @@ static void figure_load(buffer *buf, figure *f, int figure_buf_size, int version
     f->created_sequence = buffer_read_u16(buf);
     f->target_figure_created_sequence = buffer_read_u16(buf);
     f->figures_on_same_tile_index = buffer_read_u8(buf);
-    f->num_attackers = buffer_read_u8(buf);
-    f->attacker_id1 = buffer_read_i16(buf);
-    f->attacker_id2 = buffer_read_i16(buf);
-    f->opponent_id = buffer_read_i16(buf);
+    extra->num_attackers = buffer_read_u8(buf);
+    extra->attacker_id1 = buffer_read_i16(buf);
+    extra->attacker_id2 = buffer_read_i16(buf);
+    extra->opponent_id = buffer_read_i16(buf);
     if (version > SAVE_GAME_LAST_GLOBAL_BUILDING_INFO) {
         f->last_visited_index = buffer_read_i16(buf);
     }
@@ -542,15 +572,19 @@ void figure_load_state(buffer *list, buffer *seq, int version)
     int figures_to_load = (int) buf_size / figure_buf_size;
 
     if (!array_init(data.figures, FIGURE_ARRAY_SIZE_STEP, initialize_new_figure, figure_is_active) ||
-        !array_expand(data.figures, figures_to_load)) {
+        !array_expand(data.figures, figures_to_load) ||
+        !array_init(data.extras, FIGURE_ARRAY_SIZE_STEP, 0, 0) ||
+        !array_expand(data.extras, figures_to_load)) {
         log_error("Unable to create figures array. The game will now crash.", 0, 0);
     }
+    array_track_free_slots(data.figures);
 
     int highest_id_in_use = 0;
 
     for (int i = 0; i < figures_to_load; i++) {
         figure *f = array_next(data.figures);
-        figure_load(list, f, figure_buf_size, version);
+        figure_extra *extra = array_next(data.extras);
+        figure_load(list, f, extra, figure_buf_size, version);
         if (f->state) {
             highest_id_in_use = i;
         }
@@ -88,8 +88,6 @@ typedef struct {
     unsigned char wait_ticks_missile;
     signed char x_offset_cart;
     signed char y_offset_cart;
-    unsigned char empire_city_id;
-    unsigned char trader_amount_bought;
     short name;
     unsigned char terrain_usage;
     unsigned char loads_sold_or_carrying;
@@ -98,11 +96,6 @@ typedef struct {
     unsigned char current_height;
     unsigned char target_height;
     unsigned char collecting_item_id; // NOT a resource ID for cartpushers! IS a resource ID for warehousemen or lighthouse supplier
-    unsigned char trade_ship_failed_dock_attempts;
-    unsigned char phrase_sequence_exact;
-    signed char phrase_id;
-    unsigned char phrase_sequence_city;
-    unsigned char trader_id;
     unsigned char wait_ticks_next_target;
     unsigned char dont_draw_elevated;
     short target_figure_id;
@@ -110,21 +103,43 @@ typedef struct {
     unsigned short created_sequence;
     unsigned short target_figure_created_sequence;
     unsigned char figures_on_same_tile_index;
+    short last_visited_index;
+} figure;
+
+/**
+ * Figure data that only a few figure types use: trade, speech, combat and tourist bookkeeping.
+ * It is kept in a separate array indexed by figure id, so that the figure array only holds
+ * what movement and actions need on every tick.
+ */
+typedef struct {
+    unsigned char empire_city_id;
+    unsigned char trader_id;
+    unsigned char trader_amount_bought;
+    unsigned char trade_ship_failed_dock_attempts;
+    unsigned char phrase_sequence_exact;
+    signed char phrase_id;
+    unsigned char phrase_sequence_city;
     unsigned char num_attackers;
     short attacker_id1;
     short attacker_id2;
     short opponent_id;
-    short last_visited_index;
     struct {
         unsigned short tourist_money_spent;
         unsigned short ticks_since_last_visited_id[12];
         unsigned short visited_building_type_ids[12];
         unsigned char tourist_rank;
     } tourist;
-} figure;
+} figure_extra;
 
 figure *figure_get(int id);
 
+/**
+ * Gets the rarely used data of a figure
+ * @param id Figure id
+ * @return The extra data of the figure, cleared when the figure is created
+ */
+figure_extra *figure_extra_get(int id);
+
 int figure_count(void);
 
 /**
@@ -47,6 +47,7 @@ void formations_clear(void)
         !array_next(formations)) { // Ignore first formation
         log_error("Unable to create the formations array. The game will likely crash.", 0, 0);
     }
+    array_track_free_slots(formations);
     data.id_last_in_use = 0;
     data.id_last_legion = 0;
     data.num_legions = 0;
@@ -56,6 +57,7 @@ void formations_clear(void)
 void formation_clear(int formation_id)
 {
     array_item(formations, formation_id)->in_use = 0;
+    array_item_freed(formations, formation_id);
     array_trim(formations);
 }
 
@@ -789,6 +791,7 @@ void formations_load_state(buffer *buf, buffer *totals, int version)
         !array_expand(formations, formations_to_load)) {
         log_error("Unable to create the formations array. The game will likely crash.", 0, 0);
     }
+    array_track_free_slots(formations);
 
     // Reduce number of used formations. Improves performance
     int highest_id_in_use = 0;
@@ -629,7 +629,7 @@ static void update_enemy_formation(formation *m, int *roman_distance)
     for (int n = 0; n < MAX_FORMATION_FIGURES; n++) {
         figure *f = figure_get(m->figures[n]);
         if (f->action_state == FIGURE_ACTION_150_ATTACK) {
-            figure *opponent = figure_get(f->opponent_id);
+            figure *opponent = figure_get(figure_extra_get(f->id)->opponent_id);
             if (!figure_is_dead(opponent) && figure_is_legion(opponent)) {
                 formation_record_fight(m);
             }
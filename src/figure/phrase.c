@@ -286,17 +286,18 @@ int figure_phrase_play(figure *f)
         return 0;
     }
     int sound_id = FIGURE_TYPE_TO_SOUND_TYPE[f->type];
-    play_sound_file(sound_id, f->phrase_id);
+    play_sound_file(sound_id, figure_extra_get(f->id)->phrase_id);
     return sound_id;
 }
 
 static int lion_tamer_phrase(figure *f)
 {
+    figure_extra *extra = figure_extra_get(f->id);
     if (f->action_state == FIGURE_ACTION_150_ATTACK) {
-        if (++f->phrase_sequence_exact >= 3) {
-            f->phrase_sequence_exact = 0;
+        if (++extra->phrase_sequence_exact >= 3) {
+            extra->phrase_sequence_exact = 0;
         }
-        return 7 + f->phrase_sequence_exact;
+        return 7 + extra->phrase_sequence_exact;
     }
     return -1;
 }
@@ -382,18 +383,19 @@ static int warehouseman_phrase(figure *f)
 
 static int prefect_phrase(figure *f)
 {
-    if (++f->phrase_sequence_exact >= 4) {
-        f->phrase_sequence_exact = 0;
+    figure_extra *extra = figure_extra_get(f->id);
+    if (++extra->phrase_sequence_exact >= 4) {
+        extra->phrase_sequence_exact = 0;
     }
     if (f->action_state == FIGURE_ACTION_74_PREFECT_GOING_TO_FIRE) {
         return 10;
     } else if (f->action_state == FIGURE_ACTION_75_PREFECT_AT_FIRE) {
-        return 11 + (f->phrase_sequence_exact % 2);
+        return 11 + (extra->phrase_sequence_exact % 2);
     } else if (f->action_state == FIGURE_ACTION_150_ATTACK) {
-        return 13 + f->phrase_sequence_exact;
+        return 13 + extra->phrase_sequence_exact;
     } else if (f->min_max_seen >= 50) {
         // alternate between "no sign of crime around here" and the regular city phrases
-        if (f->phrase_sequence_exact % 2) {
+        if (extra->phrase_sequence_exact % 2) {
             return 7;
         } else {
             return -1;
@@ -418,42 +420,47 @@ static int engineer_phrase(figure *f)
 
 static int citizen_phrase(figure *f)
 {
-    if (++f->phrase_sequence_exact >= 3) {
-        f->phrase_sequence_exact = 0;
+    figure_extra *extra = figure_extra_get(f->id);
+    if (++extra->phrase_sequence_exact >= 3) {
+        extra->phrase_sequence_exact = 0;
     }
-    return 7 + f->phrase_sequence_exact;
+    return 7 + extra->phrase_sequence_exact;
 }
 
 static int missionary_phrase(figure *f)
 {
-    if (++f->phrase_sequence_exact >= 4) {
-        f->phrase_sequence_exact = 0;
+    figure_extra *extra = figure_extra_get(f->id);
+    if (++extra->phrase_sequence_exact >= 4) {
+        extra->phrase_sequence_exact = 0;
     }
-    return 7 + f->phrase_sequence_exact;
+    return 7 + extra->phrase_sequence_exact;
 }
 
 static int ox_phrase(figure *f)
 {
-    if (++f->phrase_sequence_exact >= 1) {
-        f->phrase_sequence_exact = 0;
+    figure_extra *extra = figure_extra_get(f->id);
+    if (++extra->phrase_sequence_exact >= 1) {
+        extra->phrase_sequence_exact = 0;
     }
-    return 7 + f->phrase_sequence_exact;
+    return 7 + extra->phrase_sequence_exact;
 }
 
 static int homeless_phrase(figure *f)
 {
-    if (++f->phrase_sequence_exact >= 2) {
-        f->phrase_sequence_exact = 0;
+    figure_extra *extra = figure_extra_get(f->id);
+    if (++extra->phrase_sequence_exact >= 2) {
+        extra->phrase_sequence_exact = 0;
     }
-    return 7 + f->phrase_sequence_exact;
+    return 7 + extra->phrase_sequence_exact;
 }
 
 static int house_seeker_phrase(figure *f)
 {
-    if (++f->phrase_sequence_exact >= 3) {
-        f->phrase_sequence_exact = 0;
+    figure_extra *extra = figure_extra_get(f->id);
+    if (++extra->phrase_sequence_exact >= 3) {
+        extra->phrase_sequence_exact = 0;
     }
-    return 7 + f->phrase_sequence_exact;
+    return 7 + extra->phrase_sequence_exact;
 }
 
 static int emigrant_phrase(void)
@@ -474,12 +481,13 @@ static int emigrant_phrase(void)
 
 static int tower_sentry_phrase(figure *f)
 {
-    if (++f->phrase_sequence_exact >= 2) {
-        f->phrase_sequence_exact = 0;
+    figure_extra *extra = figure_extra_get(f->id);
+    if (++extra->phrase_sequence_exact >= 2) {
+        extra->phrase_sequence_exact = 0;
     }
     int enemies = city_figures_enemies();
     if (!enemies) {
-        return 7 + f->phrase_sequence_exact;
+        return 7 + extra->phrase_sequence_exact;
     } else if (enemies <= 10) {
         return 9;
     } else if (enemies <= 30) {
@@ -516,27 +524,29 @@ static int docker_phrase(figure *f)
 
 static int trade_caravan_phrase(figure *f)
 {
-    if (++f->phrase_sequence_exact >= 2) {
-        f->phrase_sequence_exact = 0;
+    figure_extra *extra = figure_extra_get(f->id);
+    if (++extra->phrase_sequence_exact >= 2) {
+        extra->phrase_sequence_exact = 0;
     }
     if (f->action_state == FIGURE_ACTION_103_TRADE_CARAVAN_LEAVING) {
-        if (!trader_has_traded(f->trader_id)) {
+        if (!trader_has_traded(extra->trader_id)) {
             return 7; // no trade
         }
     } else if (f->action_state == FIGURE_ACTION_102_TRADE_CARAVAN_TRADING) {
-        if (figure_trade_caravan_can_buy(f, f->destination_building_id, f->empire_city_id)) {
+        if (figure_trade_caravan_can_buy(f, f->destination_building_id, extra->empire_city_id)) {
             return 11; // buying goods
-        } else if (figure_trade_caravan_can_sell(f, f->destination_building_id, f->empire_city_id)) {
+        } else if (figure_trade_caravan_can_sell(f, f->destination_building_id, extra->empire_city_id)) {
             return 10; // selling goods
         }
     }
-    return 8 + f->phrase_sequence_exact;
+    return 8 + extra->phrase_sequence_exact;
 }
 
 static int trade_ship_phrase(figure *f)
 {
+    figure_extra *extra = figure_extra_get(f->id);
     if (f->action_state == FIGURE_ACTION_115_TRADE_SHIP_LEAVING) {
-        if (!trader_has_traded(f->trader_id)) {
+        if (!trader_has_traded(extra->trader_id)) {
             return 9; // no trade
         } else {
             return 11; // good trade
@@ -548,14 +558,14 @@ static int trade_ship_phrase(figure *f)
         } else if (state == TRADE_SHIP_SELLING) {
             return 7; // selling goods
         } else {
-            if (!trader_has_traded(f->trader_id)) {
+            if (!trader_has_traded(extra->trader_id)) {
                 return 9; // no trade
             } else {
                 return 11; // good trade
             }
         }
     } else {
-        if (!trader_has_traded(f->trader_id)) {
+        if (!trader_has_traded(extra->trader_id)) {
             return 10; // can't wait to trade
         } else {
             return 11; // good trade
@@ -583,7 +593,7 @@ static int city_god_state(void)
 
 static int barkeep_phrase(figure *f)
 {
-    f->phrase_sequence_city = 0;
+    figure_extra_get(f->id)->phrase_sequence_city = 0;
     int god_state = city_god_state();
     int unemployment_pct = city_labor_unemployment_percentage();
 
@@ -619,10 +629,11 @@ static int barkeep_phrase(figure *f)
 
 static int beggar_phrase(figure *f)
 {
-    if (++f->phrase_sequence_exact >= 2) {
-        f->phrase_sequence_exact = 0;
+    figure_extra *extra = figure_extra_get(f->id);
+    if (++extra->phrase_sequence_exact >= 2) {
+        extra->phrase_sequence_exact = 0;
     }
-    return 7 + f->phrase_sequence_exact;
+    return 7 + extra->phrase_sequence_exact;
 }
 
 static int phrase_based_on_figure_state(figure *f)
@@ -697,7 +708,7 @@ static int phrase_based_on_figure_state(figure *f)
 
 static int phrase_based_on_city_state(figure *f)
 {
-    f->phrase_sequence_city = 0;
+    figure_extra_get(f->id)->phrase_sequence_city = 0;
     int god_state = city_god_state();
     int unemployment_pct = city_labor_unemployment_percentage();
 
@@ -738,17 +749,18 @@ void figure_phrase_determine(figure *f)
     if (f->id <= 0) {
         return;
     }
-    f->phrase_id = 0;
+    figure_extra *extra = figure_extra_get(f->id);
+    extra->phrase_id = 0;
 
     if (figure_is_enemy(f) || f->type == FIGURE_INDIGENOUS_NATIVE || f->type == FIGURE_NATIVE_TRADER) {
-        f->phrase_id = -1;
+        extra->phrase_id = -1;
         return;
     }
 
     int phrase_id = phrase_based_on_figure_state(f);
     if (phrase_id != -1) {
-        f->phrase_id = phrase_id;
+        extra->phrase_id = phrase_id;
     } else {
-        f->phrase_id = phrase_based_on_city_state(f);
+        extra->phrase_id = phrase_based_on_city_state(f);
     }
 }
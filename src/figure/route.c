@@ -2,8 +2,13 @@
 
 #include "core/array.h"
 #include "core/log.h"
+#include "game/system.h"
+#include "map/building.h"
+#include "map/grid.h"
 #include "map/routing.h"
+#include "map/routing_cache.h"
 #include "map/routing_path.h"
+#include "map/routing_regions.h"
 
 #define ARRAY_SIZE_STEP 600
 #define MAX_PATH_LENGTH 500
@@ -30,6 +35,110 @@ void figure_route_clear_all(void)
 {
     paths.size = 0;
     array_trim(paths);
+    map_routing_cache_clear();
+}
+
+static int calculate_path(routing_cache_route route, const figure *f, int direction_limit, uint8_t *directions,
+    int *path_length)
+{
+    int can_travel;
+    switch (route) {
+        case ROUTING_CACHE_WALLS:
+            can_travel = map_routing_can_travel_over_walls(f->x, f->y, f->destination_x, f->destination_y, 4);
+            break;
+        case ROUTING_CACHE_ROAD_GARDEN_HIGHWAY:
+            can_travel = map_routing_citizen_can_travel_over_road_garden_highway(f->x, f->y,
+                f->destination_x, f->destination_y, direction_limit);
+            break;
+        default:
+            can_travel = map_routing_citizen_can_travel_over_road_garden(f->x, f->y,
+                f->destination_x, f->destination_y, direction_limit);
+            break;
+    }
+    *path_length = 0;
+    if (!can_travel) {
+        return 0;
+    }
+    if (route == ROUTING_CACHE_WALLS) {
+        *path_length = map_routing_get_path(directions, f->destination_x, f->destination_y, 4);
+        if (*path_length > 0) {
+            return can_travel;
+        }
+    }
+    *path_length = map_routing_get_path(directions, f->destination_x, f->destination_y, direction_limit);
+    return can_travel;
+}
+
+static void count_cached_path(routing_cache_route route, const figure *f)
+{
+    switch (route) {
+        case ROUTING_CACHE_WALLS:
+            map_routing_count_skipped_route_over_walls();
+            break;
+        case ROUTING_CACHE_ROAD_GARDEN_HIGHWAY:
+            map_routing_count_skipped_citizen_route_over_road_garden_highway(f->destination_x, f->destination_y);
+            break;
+        default:
+            map_routing_count_skipped_citizen_route_over_road_garden(f->destination_x, f->destination_y);
+            break;
+    }
+}
+
+/**
+ * Routes that only depend on the citizen or wall routing terrain give the same path for the same
+ * source and destination until that terrain changes, so they are looked up in the routing cache first.
+ * Cached routes are still counted as the saved route counters would otherwise change.
+ */
+static int calculate_path_cached(routing_cache_route route, const figure *f, int direction_limit,
+    uint8_t *directions, int *path_length)
+{
+    int src_offset = map_grid_offset(f->x, f->y);
+    int dst_offset = map_grid_offset(f->destination_x, f->destination_y);
+    int can_travel;
+    if (map_routing_cache_get(route, src_offset, dst_offset, direction_limit, directions, path_length, &can_travel)) {
+        count_cached_path(route, f);
+        return can_travel;
+    }
+    uint64_t start = system_get_microseconds();
+    can_travel = calculate_path(route, f, direction_limit, directions, path_length);
+    map_routing_cache_store(route, src_offset, dst_offset, direction_limit, directions, *path_length, can_travel,
+        system_get_microseconds() - start);
+    return can_travel;
+}
+
+/**
+ * Enemies try three routes in turn, each of which floods everything it can reach when it fails.
+ * Routes that certainly fail because the destination is in another region are skipped,
+ * but still counted as the saved route counters would otherwise change.
+ */
+static int calculate_enemy_route(const figure *f, int direction_limit)
+{
+    int src_offset = map_grid_offset(f->x, f->y);
+    int dst_offset = map_grid_offset(f->destination_x, f->destination_y);
+    // check to see if we can reach our destination by going around the city walls
+    int may_connect_over_land = map_routing_regions_may_connect(ROUTING_REGIONS_NONCITIZEN_LAND,
+        src_offset, dst_offset);
+    int may_connect_around_walls = f->destination_building_id ?
+        map_routing_regions_may_connect_through_buildings(src_offset, dst_offset,
+            f->destination_building_id, map_building_at(dst_offset)) : may_connect_over_land;
+    if (!may_connect_around_walls) {
+        map_routing_count_skipped_noncitizen_route_over_land();
+    } else if (map_routing_noncitizen_can_travel_over_land(f->x, f->y,
+            f->destination_x, f->destination_y, direction_limit, f->destination_building_id, 5000)) {
+        return 1;
+    }
+    if (!may_connect_over_land) {
+        map_routing_count_skipped_noncitizen_route_over_land();
+    } else if (map_routing_noncitizen_can_travel_over_land(f->x, f->y,
+            f->destination_x, f->destination_y, direction_limit, 0, 25000)) {
+        return 1;
+    }
+    if (!map_routing_regions_may_connect(ROUTING_REGIONS_NONCITIZEN_ANY, src_offset, dst_offset)) {
+        map_routing_count_skipped_noncitizen_route_through_everything();
+        return 0;
+    }
+    return map_routing_noncitizen_can_travel_through_everything(f->x, f->y,
+        f->destination_x, f->destination_y, direction_limit);
 }
 
 void figure_route_clean(void)
@@ -56,9 +165,12 @@ void figure_route_add(figure *f)
     if (f->disallow_diagonal) {
         direction_limit = 4;
     }
-    if (!paths.blocks && !array_init(paths, ARRAY_SIZE_STEP, create_new_path, path_is_used)) {
-        log_error("Unable to create paths array. The game will likely crash.", 0, 0);
-        return;
+    if (!paths.blocks) {
+        if (!array_init(paths, ARRAY_SIZE_STEP, create_new_path, path_is_used)) {
+            log_error("Unable to create paths array. The game will likely crash.", 0, 0);
+            return;
+        }
+        array_track_free_slots(paths);
     }
     figure_path_data *path;
     array_new_item_after_index(paths, 1, path);
@@ -79,70 +191,60 @@ void figure_route_add(figure *f)
     } else {
         // land figure
         int can_travel;
+        int path_calculated = 0;
         switch (f->terrain_usage) {
             case TERRAIN_USAGE_ENEMY:
-                // check to see if we can reach our destination by going around the city walls
-                can_travel = map_routing_noncitizen_can_travel_over_land(f->x, f->y,
-                    f->destination_x, f->destination_y, direction_limit, f->destination_building_id, 5000);
-                if (!can_travel) {
-                    can_travel = map_routing_noncitizen_can_travel_over_land(f->x, f->y,
-                        f->destination_x, f->destination_y, direction_limit, 0, 25000);
-                    if (!can_travel) {
-                        can_travel = map_routing_noncitizen_can_travel_through_everything(
-                            f->x, f->y, f->destination_x, f->destination_y, direction_limit);
-                    }
-                }
+                can_travel = calculate_enemy_route(f, direction_limit);
                 break;
             case TERRAIN_USAGE_WALLS:
-                can_travel = map_routing_can_travel_over_walls(f->x, f->y,
-                    f->destination_x, f->destination_y, 4);
+                can_travel = calculate_path_cached(ROUTING_CACHE_WALLS, f, direction_limit,
+                    path->directions, &path_length);
+                path_calculated = 1;
                 break;
             case TERRAIN_USAGE_ANIMAL:
                 can_travel = map_routing_noncitizen_can_travel_over_land(f->x, f->y,
                     f->destination_x, f->destination_y, direction_limit, -1, 5000);
                 break;
             case TERRAIN_USAGE_PREFER_ROADS:
-                can_travel = map_routing_citizen_can_travel_over_road_garden(f->x, f->y,
-                    f->destination_x, f->destination_y, direction_limit);
+                can_travel = calculate_path_cached(ROUTING_CACHE_ROAD_GARDEN, f, direction_limit,
+                    path->directions, &path_length);
+                path_calculated = can_travel;
                 if (!can_travel) {
                     can_travel = map_routing_citizen_can_travel_over_land(f->x, f->y,
                         f->destination_x, f->destination_y, direction_limit);
                 }
                 break;
             case TERRAIN_USAGE_ROADS:
-                can_travel = map_routing_citizen_can_travel_over_road_garden(f->x, f->y,
-                    f->destination_x, f->destination_y, direction_limit);
+                can_travel = calculate_path_cached(ROUTING_CACHE_ROAD_GARDEN, f, direction_limit,
+                    path->directions, &path_length);
+                path_calculated = 1;
                 break;
             case TERRAIN_USAGE_PREFER_ROADS_HIGHWAY:
-                can_travel = map_routing_citizen_can_travel_over_road_garden_highway(f->x, f->y,
-                    f->destination_x, f->destination_y, direction_limit);
+                can_travel = calculate_path_cached(ROUTING_CACHE_ROAD_GARDEN_HIGHWAY, f, direction_limit,
+                    path->directions, &path_length);
+                path_calculated = can_travel;
                 if (!can_travel) {
                     can_travel = map_routing_citizen_can_travel_over_land(f->x, f->y,
                         f->destination_x, f->destination_y, direction_limit);
                 }
                 break;
             case TERRAIN_USAGE_ROADS_HIGHWAY:
-                can_travel = map_routing_citizen_can_travel_over_road_garden_highway(f->x, f->y,
-                    f->destination_x, f->destination_y, direction_limit);
+                can_travel = calculate_path_cached(ROUTING_CACHE_ROAD_GARDEN_HIGHWAY, f, direction_limit,
+                    path->directions, &path_length);
+                path_calculated = 1;
                 break;
             default:
                 can_travel = map_routing_citizen_can_travel_over_land(f->x, f->y,
                     f->destination_x, f->destination_y, direction_limit);
                 break;
         }
-        if (can_travel) {
-            if (f->terrain_usage == TERRAIN_USAGE_WALLS) {
-                path_length = map_routing_get_path(path->directions, f->destination_x, f->destination_y, 4);
-                if (path_length <= 0) {
-                    path_length = map_routing_get_path(path->directions,
-                        f->destination_x, f->destination_y, direction_limit);
-                }
-            } else {
+        if (!path_calculated) {
+            if (can_travel) {
                 path_length = map_routing_get_path(path->directions,
                     f->destination_x, f->destination_y, direction_limit);
+            } else { // cannot travel
+                path_length = 0;
             }
-        } else { // cannot travel
-            path_length = 0;
         }
     }
     if (path_length) {
@@ -157,6 +259,7 @@ void figure_route_remove(figure *f)
     if (f->routing_path_id > 0) {
         if (f->routing_path_id < paths.size && array_item(paths, f->routing_path_id)->figure_id == f->id) {
             array_item(paths, f->routing_path_id)->figure_id = 0;
+            array_item_freed(paths, f->routing_path_id);
         }
         f->routing_path_id = 0;
     }
@@ -194,6 +297,7 @@ void figure_route_load_state(buffer *figures, buffer *buf_paths)
         log_error("Unable to create paths array. The game will likely crash.", 0, 0);
         return;
     }
+    array_track_free_slots(paths);
 
     int highest_id_in_use = 0;
 
@@ -245,17 +245,18 @@ static void tourist_spend(building *b, figure *f)
     if (b->type == BUILDING_HIPPODROME) {
         b = building_main(b);
     }
+    figure_extra *extra = figure_extra_get(f->id);
     for (int i = 0; i <= 12; ++i) {
-        if (f->tourist.visited_building_type_ids[i]) {
-            if (f->tourist.visited_building_type_ids[i] == b->type) {
-                if (f->tourist.ticks_since_last_visited_id[i] >= TOURISM_COOLDOWN) {
+        if (extra->tourist.visited_building_type_ids[i]) {
+            if (extra->tourist.visited_building_type_ids[i] == b->type) {
+                if (extra->tourist.ticks_since_last_visited_id[i] >= TOURISM_COOLDOWN) {
                     can_pay = 1;
-                    f->tourist.ticks_since_last_visited_id[i] = 0;
+                    extra->tourist.ticks_since_last_visited_id[i] = 0;
                 }
                 break;
             }
         } else {
-            f->tourist.visited_building_type_ids[i] = b->type;
+            extra->tourist.visited_building_type_ids[i] = b->type;
             can_pay = 1;
             break;
         }
@@ -263,7 +264,7 @@ static void tourist_spend(building *b, figure *f)
 
     if (can_pay) {
         int amount = b->tourism_income;
-        f->tourist.tourist_money_spent += amount;
+        extra->tourist.tourist_money_spent += amount;
         b->tourism_income_this_year += amount;
         city_finance_treasury_add_miscellaneous(amount);
     }
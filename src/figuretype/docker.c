@@ -287,7 +287,7 @@ static int deliver_import_resource(figure *f, building *dock)
     }
     map_point tile;
     int resource = f->resource_id;
-    int destination_id = get_closest_building_for_import(f->x, f->y, ship->empire_city_id,
+    int destination_id = get_closest_building_for_import(f->x, f->y, figure_extra_get(ship->id)->empire_city_id,
         dock, &tile, &resource);
     if (!destination_id) {
         return 0;
@@ -316,19 +316,20 @@ static int fetch_export_resource(figure *f, building *dock, int add_to_bought)
         return 0;
     }
     figure *ship = figure_get(ship_id);
+    figure_extra *ship_extra = figure_extra_get(ship->id);
     if (ship->action_state != FIGURE_ACTION_112_TRADE_SHIP_MOORED ||
-        (add_to_bought && ship->trader_amount_bought >= figure_trade_sea_trade_units())) {
+        (add_to_bought && ship_extra->trader_amount_bought >= figure_trade_sea_trade_units())) {
         return 0;
     }
     map_point tile;
     int resource = f->resource_id;
-    int destination_id = get_closest_building_for_export(f->x, f->y, ship->empire_city_id,
+    int destination_id = get_closest_building_for_export(f->x, f->y, ship_extra->empire_city_id,
         dock, &tile, &resource);
     if (!destination_id) {
         return 0;
     }
     if (add_to_bought) {
-        ship->trader_amount_bought++;
+        ship_extra->trader_amount_bought++;
     }
     if (f->destination_building_id != destination_id) {
         figure_route_remove(f);
@@ -520,12 +521,12 @@ void figure_docker_action(figure *f)
             if (f->wait_ticks > 10) {
                 int trade_city_id;
                 if (b->data.dock.trade_ship_id) {
-                    trade_city_id = figure_get(b->data.dock.trade_ship_id)->empire_city_id;
+                    trade_city_id = figure_extra_get(b->data.dock.trade_ship_id)->empire_city_id;
                 } else {
                     trade_city_id = 0;
                 }
                 if (try_import_resource(f->destination_building_id, f->resource_id, trade_city_id)) {
-                    int trader_id = figure_get(b->data.dock.trade_ship_id)->trader_id;
+                    int trader_id = figure_extra_get(b->data.dock.trade_ship_id)->trader_id;
                     trader_record_sold_resource(trader_id, f->resource_id);
                     city_health_update_sickness_level_in_building(b->id);
                     city_health_dispatch_sickness(f);
@@ -550,7 +551,7 @@ void figure_docker_action(figure *f)
             if (f->wait_ticks > 10) {
                 int trade_city_id;
                 if (b->data.dock.trade_ship_id) {
-                    trade_city_id = figure_get(b->data.dock.trade_ship_id)->empire_city_id;
+                    trade_city_id = figure_extra_get(b->data.dock.trade_ship_id)->empire_city_id;
                 } else {
                     trade_city_id = 0;
                 }
@@ -559,7 +560,7 @@ void figure_docker_action(figure *f)
                 f->destination_y = f->source_y;
                 f->wait_ticks = 0;
                 if (try_export_resource(f->destination_building_id, f->resource_id, trade_city_id)) {
-                    int trader_id = figure_get(b->data.dock.trade_ship_id)->trader_id;
+                    int trader_id = figure_extra_get(b->data.dock.trade_ship_id)->trader_id;
                     trader_record_bought_resource(trader_id, f->resource_id);
                     city_health_update_sickness_level_in_building(b->id);
                     city_health_dispatch_sickness(f);
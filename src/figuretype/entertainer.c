@@ -491,8 +491,8 @@ void figure_tourist_action(figure *f)
             f->is_ghost = 0;
             figure_movement_move_ticks(f, 1);
             for (int i = 0; i < 12; ++i) {
-                if (f->tourist.visited_building_type_ids[i]) {
-                    f->tourist.ticks_since_last_visited_id[i]++;
+                if (figure_extra_get(f->id)->tourist.visited_building_type_ids[i]) {
+                    figure_extra_get(f->id)->tourist.ticks_since_last_visited_id[i]++;
                 }
             }
             if (f->direction == DIR_FIGURE_AT_DESTINATION) {
@@ -64,7 +64,7 @@ static int sea_trader_bonus_speed(void)
 int figure_create_trade_caravan(int x, int y, int city_id)
 {
     figure *caravan = figure_create(FIGURE_TRADE_CARAVAN, x, y, DIR_0_TOP);
-    caravan->empire_city_id = city_id;
+    figure_extra_get(caravan->id)->empire_city_id = city_id;
     caravan->action_state = FIGURE_ACTION_100_TRADE_CARAVAN_CREATED;
     random_generate_next();
     caravan->wait_ticks = random_byte() & TRADER_INITIAL_WAIT;
@@ -82,7 +82,7 @@ int figure_create_trade_caravan(int x, int y, int city_id)
 int figure_create_trade_ship(int x, int y, int city_id)
 {
     figure *ship = figure_create(FIGURE_TRADE_SHIP, x, y, DIR_0_TOP);
-    ship->empire_city_id = city_id;
+    figure_extra_get(ship->id)->empire_city_id = city_id;
     ship->action_state = FIGURE_ACTION_110_TRADE_SHIP_CREATED;
     random_generate_next();
     ship->wait_ticks = random_byte() & TRADER_INITIAL_WAIT;
@@ -99,7 +99,7 @@ int figure_trade_caravan_can_buy(figure *trader, int building_id, int city_id)
     if (b->has_plague) {
         return 0;
     }
-    if (trader->trader_amount_bought >= figure_trade_land_trade_units()) {
+    if (figure_extra_get(trader->id)->trader_amount_bought >= figure_trade_land_trade_units()) {
         return 0;
     }
     if (!building_storage_get_permission(BUILDING_STORAGE_PERMISSION_TRADERS, b)) {
@@ -327,7 +327,7 @@ static int get_closest_storage(const figure *f, int x, int y, int city_id, map_p
     importable[RESOURCE_NONE] = 0;
     for (int r = RESOURCE_MIN; r < RESOURCE_MAX; r++) {
         exportable[r] = empire_can_export_resource_to_city(city_id, r);
-        if (f->trader_amount_bought >= figure_trade_land_trade_units()) {
+        if (figure_extra_get(f->id)->trader_amount_bought >= figure_trade_land_trade_units()) {
             exportable[r] = 0;
         }
         if (city_id) {
@@ -443,7 +443,7 @@ static int get_closest_storage(const figure *f, int x, int y, int city_id, map_p
 static void go_to_next_storage(figure *f)
 {
     map_point dst;
-    int destination_id = get_closest_storage(f, f->x, f->y, f->empire_city_id, &dst);
+    int destination_id = get_closest_storage(f, f->x, f->y, figure_extra_get(f->id)->empire_city_id, &dst);
     if (destination_id) {
         f->destination_building_id = destination_id;
         f->action_state = FIGURE_ACTION_101_TRADE_CARAVAN_ARRIVING;
@@ -468,6 +468,7 @@ static int trader_image_id(void)
 
 void figure_trade_caravan_action(figure *f)
 {
+    figure_extra *extra = figure_extra_get(f->id);
     int move_speed = trader_bonus_speed();
 
     f->is_ghost = 0;
@@ -513,25 +514,25 @@ void figure_trade_caravan_action(figure *f)
             if (f->wait_ticks > 10) {
                 f->wait_ticks = 0;
                 int move_on = 0;
-                if (figure_trade_caravan_can_buy(f, f->destination_building_id, f->empire_city_id)) {
-                    int resource = trader_get_buy_resource(f->destination_building_id, f->empire_city_id);
+                if (figure_trade_caravan_can_buy(f, f->destination_building_id, extra->empire_city_id)) {
+                    int resource = trader_get_buy_resource(f->destination_building_id, extra->empire_city_id);
                     if (resource) {
-                        trade_route_increase_traded(empire_city_get_route_id(f->empire_city_id), resource);
-                        trader_record_bought_resource(f->trader_id, resource);
+                        trade_route_increase_traded(empire_city_get_route_id(extra->empire_city_id), resource);
+                        trader_record_bought_resource(extra->trader_id, resource);
                         city_health_update_sickness_level_in_building(f->destination_building_id);
 
-                        f->trader_amount_bought++;
+                        extra->trader_amount_bought++;
                     } else {
                         move_on++;
                     }
                 } else {
                     move_on++;
                 }
-                if (figure_trade_caravan_can_sell(f, f->destination_building_id, f->empire_city_id)) {
-                    int resource = trader_get_sell_resource(f->destination_building_id, f->empire_city_id);
+                if (figure_trade_caravan_can_sell(f, f->destination_building_id, extra->empire_city_id)) {
+                    int resource = trader_get_sell_resource(f->destination_building_id, extra->empire_city_id);
                     if (resource) {
-                        trade_route_increase_traded(empire_city_get_route_id(f->empire_city_id), resource);
-                        trader_record_sold_resource(f->trader_id, resource);
+                        trade_route_increase_traded(empire_city_get_route_id(extra->empire_city_id), resource);
+                        trader_record_sold_resource(extra->trader_id, resource);
                         city_health_update_sickness_level_in_building(f->destination_building_id);
                         f->loads_sold_or_carrying++;
                     } else {
@@ -602,6 +603,7 @@ void figure_trade_caravan_donkey_action(figure *f)
 
 void figure_native_trader_action(figure *f)
 {
+    figure_extra *extra = figure_extra_get(f->id);
     int move_speed = trader_bonus_speed();
 
     f->is_ghost = 0;
@@ -661,9 +663,9 @@ void figure_native_trader_action(figure *f)
                 f->wait_ticks = 0;
                 if (figure_trade_caravan_can_buy(f, f->destination_building_id, 0)) {
                     int resource = trader_get_buy_resource(f->destination_building_id, 0);
-                    trader_record_bought_resource(f->trader_id, resource);
+                    trader_record_bought_resource(extra->trader_id, resource);
                     city_health_update_sickness_level_in_building(f->destination_building_id);
-                    f->trader_amount_bought += 3;
+                    extra->trader_amount_bought += 3;
                 } else {
                     map_point tile;
                     int building_id = get_closest_storage(f, f->x, f->y, 0, &tile);
@@ -726,6 +728,7 @@ int figure_trade_ship_is_trading(figure *ship)
 
 static int trade_dock_ignoring_ship(figure *f)
 {
+    figure_extra *extra = figure_extra_get(f->id);
     building *b = building_get(f->destination_building_id);
     if (b->state == BUILDING_STATE_IN_USE && b->type == BUILDING_DOCK && b->num_workers > 0 && b->data.dock.trade_ship_id == f->id) {
         for (int i = 0; i < 3; i++) {
@@ -736,9 +739,9 @@ static int trade_dock_ignoring_ship(figure *f)
                 }
             }
         }
-        f->trade_ship_failed_dock_attempts++;
-        if (f->trade_ship_failed_dock_attempts >= 10) {
-            f->trade_ship_failed_dock_attempts = 11;
+        extra->trade_ship_failed_dock_attempts++;
+        if (extra->trade_ship_failed_dock_attempts >= 10) {
+            extra->trade_ship_failed_dock_attempts = 11;
             return 1;
         }
         return 0;
@@ -758,6 +761,7 @@ static int record_dock(figure *ship, int dock_id)
 
 void figure_trade_ship_action(figure *f)
 {
+    figure_extra *extra = figure_extra_get(f->id);
     int move_speed = sea_trader_bonus_speed();
     f->is_ghost = 0;
     f->is_boat = 1;
@@ -772,7 +776,7 @@ void figure_trade_ship_action(figure *f)
             break;
         case FIGURE_ACTION_110_TRADE_SHIP_CREATED:
             f->loads_sold_or_carrying = figure_trade_sea_trade_units();
-            f->trader_amount_bought = 0;
+            extra->trader_amount_bought = 0;
             f->is_ghost = 1;
             f->wait_ticks++;
             if (f->wait_ticks > TRADER_INITIAL_WAIT) {
@@ -890,7 +894,7 @@ void figure_trade_ship_action(figure *f)
         case FIGURE_ACTION_111_TRADE_SHIP_GOING_TO_DOCK:
             figure_movement_move_ticks_with_percentage(f, 1, move_speed);
             f->height_adjusted_ticks = 0;
-            f->trade_ship_failed_dock_attempts = 0;
+            extra->trade_ship_failed_dock_attempts = 0;
             if (f->direction == DIR_FIGURE_AT_DESTINATION) {
                 if (record_dock(f, f->destination_building_id)) {
                     f->action_state = FIGURE_ACTION_112_TRADE_SHIP_MOORED;
@@ -924,7 +928,7 @@ void figure_trade_ship_action(figure *f)
                     f->destination_y = tile.y;
                 } else {
                     f->destination_building_id = 0;
-                    f->trade_ship_failed_dock_attempts = 0;
+                    extra->trade_ship_failed_dock_attempts = 0;
                     f->action_state = FIGURE_ACTION_115_TRADE_SHIP_LEAVING;
                     f->wait_ticks = 0;
                     map_point river_entry = scenario_map_river_entry();
@@ -1049,7 +1053,7 @@ int figure_trader_ship_can_queue_for_import(figure *ship)
 int figure_trader_ship_can_queue_for_export(figure *ship)
 {
     if (ship->action_state == FIGURE_ACTION_112_TRADE_SHIP_MOORED) {
-        int available_space = figure_trade_sea_trade_units() - ship->trader_amount_bought;
+        int available_space = figure_trade_sea_trade_units() - figure_extra_get(ship->id)->trader_amount_bought;
         return available_space >= (figure_trade_sea_trade_units() / 3);
     }
     return 1;
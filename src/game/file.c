@@ -452,6 +452,16 @@ int game_file_write_saved_game(const char *filename)
     return game_file_io_write_saved_game(filename);
 }
 
+int game_file_write_saved_game_in_background(const char *filename)
+{
+    return game_file_io_write_saved_game_in_background(filename);
+}
+
+void game_file_finish_background_saves(void)
+{
+    game_file_io_wait_for_background_saves();
+}
+
 int game_file_delete_saved_game(const char *filename)
 {
     return game_file_io_delete_saved_game(filename);
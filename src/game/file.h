@@ -41,6 +41,18 @@ int game_file_load_saved_game(const char *filename);
  */
 int game_file_write_saved_game(const char *filename);
 
+/**
+ * Write saved game to disk on a background thread, used for autosaves
+ * @param filename File to save to
+ * @return Boolean true if the save was started, false on failure
+ */
+int game_file_write_saved_game_in_background(const char *filename);
+
+/**
+ * Wait for saves that are still being written in the background
+ */
+void game_file_finish_background_saves(void);
+
 /**
  * Delete saved game
  * @param filename File to delete
@@ -31,6 +31,7 @@
 #include "figure/visited_buildings.h"
 #include "game/file.h"
 #include "game/save_version.h"
+#include "game/system.h"
 #include "game/time.h"
 #include "game/tutorial.h"
 #include "map/aqueduct.h"
@@ -46,6 +47,8 @@
 #include "map/sprite.h"
 #include "map/terrain.h"
 #include "map/tiles.h"
+#include "platform/file_manager_cache.h"
+#include "platform/thread.h"
 #include "scenario/allowed_building.h"
 #include "scenario/criteria.h"
 #include "scenario/custom_media.h"
@@ -73,6 +76,16 @@
 #define COMPRESS_BUFFER_INITIAL_SIZE 1000000
 #define UNCOMPRESSED 0x80000000
 #define PIECE_SIZE_DYNAMIC 0
+#define MAX_PENDING_SAVES 2
+#define MAX_COMPRESS_THREADS 8
+#define PIECE_TIMINGS_TO_REPORT 3
+
+// Writing a file updates the file cache of the consoles and syncs the web filesystem, neither of which is thread safe
+#if defined(USE_FILE_CACHE) || defined(__EMSCRIPTEN__)
+#define BACKGROUND_SAVES_SUPPORTED 0
+#else
+#define BACKGROUND_SAVES_SUPPORTED 1
+#endif
 
 typedef struct {
     buffer buf;
@@ -283,6 +296,24 @@ static struct {
     savegame_state state;
 } savegame_data;
 
+typedef struct {
+    char filename[FILE_NAME_MAX];
+    int num_pieces;
+    file_piece pieces[sizeof(savegame_state) / sizeof(buffer *) + 1];
+} savegame_snapshot;
+
+static struct {
+    uint64_t piece_micros[sizeof(savegame_state) / sizeof(buffer *) + 1];
+    uint64_t total_micros;
+} load_timings;
+
+static struct {
+    platform_mutex *mutex;
+    platform_thread *thread;
+    int writing;
+    savegame_snapshot *pending[MAX_PENDING_SAVES];
+} background_save;
+
 static struct {
     minimap_functions functions;
     savegame_version_t version;
@@ -1368,11 +1399,43 @@ int game_file_io_write_scenario(const char *filename)
     return 1;
 }
 
+static void log_piece_timings(const char *action, const uint64_t *piece_micros, int num_pieces,
+    uint64_t total_micros)
+{
+    char message[200];
+    int length = snprintf(message, sizeof(message), "%s %d pieces in %d ms, slowest:",
+        action, num_pieces, (int) (total_micros / 1000));
+    int reported[PIECE_TIMINGS_TO_REPORT];
+    for (int i = 0; i < PIECE_TIMINGS_TO_REPORT && i < num_pieces; i++) {
+        int slowest = -1;
+        for (int piece = 0; piece < num_pieces; piece++) {
+            int already_reported = 0;
+            for (int j = 0; j < i; j++) {
+                if (reported[j] == piece) {
+                    already_reported = 1;
+                }
+            }
+            if (!already_reported && (slowest < 0 || piece_micros[piece] > piece_micros[slowest])) {
+                slowest = piece;
+            }
+        }
+        reported[i] = slowest;
+        if (length < (int) sizeof(message)) {
+            length += snprintf(&message[length], sizeof(message) - length, " #%d (%d us)",
+                slowest, (int) piece_micros[slowest]);
+        }
+    }
+    log_info(message, 0, 0);
+}
+
 static int savegame_read_from_buffer(buffer *buf, savegame_version_t version)
 {
+    uint64_t start = system_get_microseconds();
+    memset(&load_timings, 0, sizeof(load_timings));
     memory_block compress_buffer;
     core_memory_block_init(&compress_buffer, COMPRESS_BUFFER_INITIAL_SIZE);
     for (int i = 0; i < savegame_data.num_pieces; i++) {
+        uint64_t piece_start = system_get_microseconds();
         file_piece *piece = &savegame_data.pieces[i];
         size_t result = 0;
         if (!prepare_dynamic_piece_from_buffer(buf, piece)) {
@@ -1391,16 +1454,21 @@ static int savegame_read_from_buffer(buffer *buf, savegame_version_t version)
             core_memory_block_free(&compress_buffer);
             return 0;
         }
+        load_timings.piece_micros[i] = system_get_microseconds() - piece_start;
     }
     core_memory_block_free(&compress_buffer);
+    load_timings.total_micros = system_get_microseconds() - start;
     return 1;
 }
 
 static int savegame_read_from_file(FILE *fp, savegame_version_t version)
 {
+    uint64_t start = system_get_microseconds();
+    memset(&load_timings, 0, sizeof(load_timings));
     memory_block compress_buffer;
     core_memory_block_init(&compress_buffer, COMPRESS_BUFFER_INITIAL_SIZE);
     for (int i = 0; i < savegame_data.num_pieces; i++) {
+        uint64_t piece_start = system_get_microseconds();
         file_piece *piece = &savegame_data.pieces[i];
         int result = 0;
         if (!prepare_dynamic_piece_from_file(fp, piece)) {
@@ -1418,27 +1486,150 @@ static int savegame_read_from_file(FILE *fp, savegame_version_t version)
             core_memory_block_free(&compress_buffer);
             return 0;
         }
+        load_timings.piece_micros[i] = system_get_microseconds() - piece_start;
     }
     core_memory_block_free(&compress_buffer);
+    load_timings.total_micros = system_get_microseconds() - start;
     return 1;
 }
 
-static void savegame_write_to_file(FILE *fp, memory_block *compress_buffer)
+typedef struct {
+    void *data;
+    int size;
+    uint64_t micros;
+} compressed_piece;
+
+typedef struct {
+    const file_piece *pieces;
+    compressed_piece *results;
+    int indexes[sizeof(savegame_state) / sizeof(buffer *) + 1];
+    int num_indexes;
+    int next_index;
+    platform_mutex *mutex;
+} compression_job;
+
+static int next_piece_to_compress(compression_job *job)
 {
-    for (int i = 0; i < savegame_data.num_pieces; i++) {
-        file_piece *piece = &savegame_data.pieces[i];
+    int index = -1;
+    if (job->mutex) {
+        platform_mutex_lock(job->mutex);
+    }
+    if (job->next_index < job->num_indexes) {
+        index = job->indexes[job->next_index++];
+    }
+    if (job->mutex) {
+        platform_mutex_unlock(job->mutex);
+    }
+    return index;
+}
+
+static void compress_piece(const file_piece *piece, compressed_piece *result, memory_block *scratch)
+{
+    uint64_t start = system_get_microseconds();
+    // Same output limit as write_compressed_chunk so the files are identical
+    if (scratch->size >= COMPRESS_BUFFER_INITIAL_SIZE &&
+        core_memory_block_ensure_size(scratch, piece->buf.size)) {
+        int output_size = 0;
+        if (zlib_helper_compress(piece->buf.data, (int) piece->buf.size, scratch->memory,
+            COMPRESS_BUFFER_INITIAL_SIZE, &output_size)) {
+            result->data = malloc(output_size);
+            if (result->data) {
+                memcpy(result->data, scratch->memory, output_size);
+                result->size = output_size;
+            }
+        }
+    }
+    result->micros = system_get_microseconds() - start;
+}
+
+static int compress_pieces(void *data)
+{
+    compression_job *job = data;
+    memory_block scratch;
+    core_memory_block_init(&scratch, COMPRESS_BUFFER_INITIAL_SIZE);
+    int index;
+    while ((index = next_piece_to_compress(job)) >= 0) {
+        compress_piece(&job->pieces[index], &job->results[index], &scratch);
+    }
+    core_memory_block_free(&scratch);
+    return 0;
+}
+
+static void compress_pieces_in_parallel(compression_job *job)
+{
+    int num_threads = platform_thread_cpu_count() - 1;
+    if (num_threads > job->num_indexes - 1) {
+        num_threads = job->num_indexes - 1;
+    }
+    if (num_threads > MAX_COMPRESS_THREADS - 1) {
+        num_threads = MAX_COMPRESS_THREADS - 1;
+    }
+    platform_thread *threads[MAX_COMPRESS_THREADS];
+    int threads_started = 0;
+    if (num_threads > 0) {
+        job->mutex = platform_mutex_create();
+    }
+    if (job->mutex) {
+        for (int i = 0; i < num_threads; i++) {
+            threads[threads_started] = platform_thread_create(compress_pieces, "savegame compression", job);
+            if (!threads[threads_started]) {
+                break;
+            }
+            threads_started++;
+        }
+    }
+    // The calling thread does its share of the work too
+    compress_pieces(job);
+    for (int i = 0; i < threads_started; i++) {
+        platform_thread_wait(threads[i]);
+    }
+    if (job->mutex) {
+        platform_mutex_destroy(job->mutex);
+        job->mutex = 0;
+    }
+}
+
+static void savegame_write_to_file(FILE *fp, const file_piece *pieces, int num_pieces)
+{
+    uint64_t start = system_get_microseconds();
+    compressed_piece results[sizeof(savegame_state) / sizeof(buffer *) + 1];
+    memset(results, 0, sizeof(results));
+
+    compression_job job;
+    memset(&job, 0, sizeof(job));
+    job.pieces = pieces;
+    job.results = results;
+    for (int i = 0; i < num_pieces; i++) {
+        if (pieces[i].compressed && pieces[i].buf.size) {
+            job.indexes[job.num_indexes++] = i;
+        }
+    }
+    compress_pieces_in_parallel(&job);
+
+    uint64_t piece_micros[sizeof(savegame_state) / sizeof(buffer *) + 1];
+    for (int i = 0; i < num_pieces; i++) {
+        uint64_t write_start = system_get_microseconds();
+        const file_piece *piece = &pieces[i];
+        compressed_piece *result = &results[i];
         if (piece->dynamic) {
             write_int32(fp, (int) piece->buf.size);
-            if (!piece->buf.size) {
-                continue;
-            }
         }
-        if (piece->compressed) {
-            write_compressed_chunk(fp, piece->buf.data, piece->buf.size, compress_buffer);
+        if (!piece->buf.size) {
+            // Empty dynamic pieces only have their size
+        } else if (piece->compressed && result->data) {
+            write_int32(fp, result->size);
+            fwrite(result->data, 1, result->size, fp);
+        } else if (piece->compressed) {
+            // unable to compress: write uncompressed
+            write_int32(fp, UNCOMPRESSED);
+            fwrite(piece->buf.data, 1, piece->buf.size, fp);
         } else {
             fwrite(piece->buf.data, 1, piece->buf.size, fp);
         }
+        free(result->data);
+        piece_micros[i] = result->micros + system_get_microseconds() - write_start;
     }
+    log_piece_timings("Saved", piece_micros, num_pieces, system_get_microseconds() - start);
 }
 
 static int get_savegame_versions_from_buffer(buffer *buf, savegame_version_t *save_version,
@@ -1501,6 +1692,7 @@ int game_file_io_read_save_game_from_buffer(buffer *buf)
         log_error("Unable to load game, incompatible savefile.", 0, 0);
         return FILE_LOAD_WRONG_FILE_FORMAT;
     }
+    log_piece_timings("Loaded", load_timings.piece_micros, savegame_data.num_pieces, load_timings.total_micros);
     savegame_load_from_state(&savegame_data.state, save_version);
     clear_savegame_pieces();
     return FILE_LOAD_SUCCESS;
@@ -1536,6 +1728,7 @@ int game_file_io_read_saved_game(const char *filename, int offset)
         log_error("Unable to load game, incompatible savefile.", 0, 0);
         return FILE_LOAD_WRONG_FILE_FORMAT;
     }
+    log_piece_timings("Loaded", load_timings.piece_micros, savegame_data.num_pieces, load_timings.total_micros);
     savegame_load_from_state(&savegame_data.state, save_version);
     clear_savegame_pieces();
     return 1;
@@ -1733,6 +1926,9 @@ int game_file_io_read_saved_game_info_from_buffer(buffer *buf, saved_game_info *
 
 int game_file_io_write_saved_game(const char *filename)
 {
+    // Don't let a pending autosave overwrite what we're about to save
+    game_file_io_wait_for_background_saves();
+
     resource_set_mapping(RESOURCE_CURRENT_VERSION);
     init_savegame_data(SAVE_GAME_CURRENT_VERSION);
 
@@ -1744,17 +1940,180 @@ int game_file_io_write_saved_game(const char *filename)
         log_error("Unable to save game", 0, 0);
         return 0;
     }
-    memory_block compress_buffer;
-    core_memory_block_init(&compress_buffer, COMPRESS_BUFFER_INITIAL_SIZE);
-    savegame_write_to_file(fp, &compress_buffer);
-    core_memory_block_free(&compress_buffer);
+    savegame_write_to_file(fp, savegame_data.pieces, savegame_data.num_pieces);
+    clear_savegame_pieces();
+    file_close(fp);
+    return 1;
+}
+
+static uint32_t hash_piece(const buffer *buf)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < buf->size; i++) {
+        hash ^= buf->data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+int game_file_io_hash_saved_game_state(uint32_t *hashes, int max_pieces)
+{
+    resource_set_mapping(RESOURCE_CURRENT_VERSION);
+    init_savegame_data(SAVE_GAME_CURRENT_VERSION);
+    savegame_save_to_state(&savegame_data.state);
+
+    int num_pieces = savegame_data.num_pieces < max_pieces ? savegame_data.num_pieces : max_pieces;
+    for (int i = 0; i < num_pieces; i++) {
+        hashes[i] = hash_piece(&savegame_data.pieces[i].buf);
+    }
     clear_savegame_pieces();
+    return num_pieces;
+}
+
+static savegame_snapshot *take_savegame_snapshot(const char *filename)
+{
+    savegame_snapshot *snapshot = malloc(sizeof(savegame_snapshot));
+    if (!snapshot) {
+        log_error("Unable to save game: out of memory", 0, 0);
+        return 0;
+    }
+    resource_set_mapping(RESOURCE_CURRENT_VERSION);
+    init_savegame_data(SAVE_GAME_CURRENT_VERSION);
+
+    log_info("Saving game", filename, 0);
+    savegame_save_to_state(&savegame_data.state);
+
+    // Take ownership of the piece buffers, the next save allocates new ones
+    snprintf(snapshot->filename, FILE_NAME_MAX, "%s", filename);
+    snapshot->num_pieces = savegame_data.num_pieces;
+    memcpy(snapshot->pieces, savegame_data.pieces, sizeof(file_piece) * savegame_data.num_pieces);
+    savegame_data.num_pieces = 0;
+    return snapshot;
+}
+
+static void free_savegame_snapshot(savegame_snapshot *snapshot)
+{
+    for (int i = 0; i < snapshot->num_pieces; i++) {
+        free(snapshot->pieces[i].buf.data);
+    }
+    free(snapshot);
+}
+
+static int write_savegame_snapshot(const savegame_snapshot *snapshot)
+{
+    // Write to a temporary file first so an interrupted save never leaves a broken file behind
+    char temp_filename[FILE_NAME_MAX];
+    snprintf(temp_filename, FILE_NAME_MAX, "%s.tmp", snapshot->filename);
+    FILE *fp = file_open(temp_filename, "wb");
+    if (!fp) {
+        log_error("Unable to save game", snapshot->filename, 0);
+        return 0;
+    }
+    savegame_write_to_file(fp, snapshot->pieces, snapshot->num_pieces);
     file_close(fp);
+    if (!file_rename(temp_filename, snapshot->filename)) {
+        log_error("Unable to save game", snapshot->filename, 0);
+        file_remove(temp_filename);
+        return 0;
+    }
     return 1;
 }
 
+static int background_save_thread(void *data)
+{
+    savegame_snapshot *snapshot = data;
+    while (snapshot) {
+        write_savegame_snapshot(snapshot);
+        free_savegame_snapshot(snapshot);
+
+        platform_mutex_lock(background_save.mutex);
+        snapshot = background_save.pending[0];
+        for (int i = 1; i < MAX_PENDING_SAVES; i++) {
+            background_save.pending[i - 1] = background_save.pending[i];
+        }
+        background_save.pending[MAX_PENDING_SAVES - 1] = 0;
+        if (!snapshot) {
+            background_save.writing = 0;
+        }
+        platform_mutex_unlock(background_save.mutex);
+    }
+    return 0;
+}
+
+static int queue_savegame_snapshot(savegame_snapshot *snapshot)
+{
+    for (int i = 0; i < MAX_PENDING_SAVES; i++) {
+        savegame_snapshot *pending = background_save.pending[i];
+        if (!pending) {
+            background_save.pending[i] = snapshot;
+            return 1;
+        }
+        if (strcmp(pending->filename, snapshot->filename) == 0) {
+            // Not written yet and already outdated
+            free_savegame_snapshot(pending);
+            background_save.pending[i] = snapshot;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int game_file_io_write_saved_game_in_background(const char *filename)
+{
+    if (!BACKGROUND_SAVES_SUPPORTED) {
+        return game_file_io_write_saved_game(filename);
+    }
+    if (!background_save.mutex) {
+        background_save.mutex = platform_mutex_create();
+        if (!background_save.mutex) {
+            return game_file_io_write_saved_game(filename);
+        }
+    }
+    savegame_snapshot *snapshot = take_savegame_snapshot(filename);
+    if (!snapshot) {
+        return 0;
+    }
+    platform_mutex_lock(background_save.mutex);
+    if (background_save.writing) {
+        int queued = queue_savegame_snapshot(snapshot);
+        platform_mutex_unlock(background_save.mutex);
+        if (!queued) {
+            log_info("Too many pending saves, saving now", filename, 0);
+            int result = write_savegame_snapshot(snapshot);
+            free_savegame_snapshot(snapshot);
+            return result;
+        }
+        return 1;
+    }
+    background_save.writing = 1;
+    platform_mutex_unlock(background_save.mutex);
+
+    // The previous thread has nothing left to write and is about to exit
+    if (background_save.thread) {
+        platform_thread_wait(background_save.thread);
+    }
+    background_save.thread = platform_thread_create(background_save_thread, "background save", snapshot);
+    if (!background_save.thread) {
+        background_save.writing = 0;
+        int result = write_savegame_snapshot(snapshot);
+        free_savegame_snapshot(snapshot);
+        return result;
+    }
+    return 1;
+}
+
+void game_file_io_wait_for_background_saves(void)
+{
+    if (background_save.thread) {
+        platform_thread_wait(background_save.thread);
+        background_save.thread = 0;
+    }
+}
+
 int game_file_io_delete_saved_game(const char *filename)
 {
+    game_file_io_wait_for_background_saves();
     log_info("Deleting game", filename, 0);
     int result = file_remove(filename);
     if (!result) {
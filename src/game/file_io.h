@@ -53,6 +53,29 @@ int game_file_io_read_saved_game_info_from_buffer(buffer *buf, saved_game_info *
 
 int game_file_io_write_saved_game(const char *filename);
 
+/**
+ * Saves the game without blocking on compression and disk access.
+ * The game state is copied right away, the file is written on a background thread.
+ * On platforms where file access isn't thread safe, the game is saved right away instead.
+ * @param filename File to save to
+ * @return 1 if the save was started, 0 otherwise
+ */
+int game_file_io_write_saved_game_in_background(const char *filename);
+
+/**
+ * Blocks until all saves started with game_file_io_write_saved_game_in_background are written
+ */
+void game_file_io_wait_for_background_saves(void);
+
 int game_file_io_delete_saved_game(const char *filename);
 
+/**
+ * Serializes the current game state the same way saving does and hashes every savegame piece.
+ * Pieces are numbered in file order, as in the piece timings that are logged on save and load.
+ * @param hashes Array to store one hash per piece in
+ * @param max_pieces Size of the array
+ * @return Number of pieces that were hashed
+ */
+int game_file_io_hash_saved_game_state(uint32_t *hashes, int max_pieces);
+
 #endif // GAME_FILE_IO_H
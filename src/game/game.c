@@ -5,8 +5,10 @@
 #include "building/properties.h"
 #include "city/view.h"
 #include "core/config.h"
+#include "core/encoding.h"
 #include "core/hotkey_config.h"
 #include "core/image.h"
+#include "core/jobs.h"
 #include "core/lang.h"
 #include "core/locale.h"
 #include "core/log.h"
@@ -18,10 +20,12 @@
 #include "game/campaign.h"
 #include "game/file.h"
 #include "game/file_editor.h"
+#include "game/replay.h"
 #include "game/settings.h"
 #include "game/speed.h"
 #include "game/state.h"
 #include "game/tick.h"
+#include "game/tick_profiler.h"
 #include "graphics/font.h"
 #include "graphics/graphics.h"
 #include "graphics/text.h"
@@ -39,6 +43,10 @@
 #include "window/logo.h"
 #include "window/main_menu.h"
 
+#include <stdio.h>
+
+#define PROFILER_OVERLAY_LINES 8
+
 static void errlog(const char *msg)
 {
     log_error(msg, 0, 0);
@@ -140,6 +148,27 @@ int game_init(void)
     return 1;
 }
 
+int game_init_headless(void)
+{
+    if (!image_load_climate(CLIMATE_CENTRAL, 0, 1, 0)) {
+        errlog("unable to load main graphics");
+        return 0;
+    }
+    if (!image_load_enemy(ENEMY_0_BARBARIAN)) {
+        errlog("unable to load enemy graphics");
+        return 0;
+    }
+    if (!model_load()) {
+        errlog("unable to load c3_model.txt");
+        return 0;
+    }
+    building_properties_init();
+    load_augustus_messages();
+    game_state_init();
+    resource_init();
+    return 1;
+}
+
 static int reload_language(int is_editor, int reload_images)
 {
     if (!lang_load(is_editor)) {
@@ -204,7 +233,7 @@ int game_reload_language(void)
 void game_run(void)
 {
     game_animation_update();
-    int num_ticks = game_speed_get_elapsed_ticks();
+    int num_ticks = game_replay_get_ticks_to_run(game_speed_get_elapsed_ticks());
     for (int i = 0; i < num_ticks; i++) {
         game_tick_run();
         game_file_write_mission_saved_game();
@@ -232,8 +261,34 @@ void game_display_fps(int fps)
     text_draw_number_centered_colored(fps, x_offset, y_offset + 6, width, FONT_SMALL_PLAIN, COLOR_BLACK);
 }
 
+void game_display_tick_profiler(void)
+{
+    tick_profiler_stats stats[PROFILER_OVERLAY_LINES];
+    int lines = tick_profiler_get_slowest(stats, PROFILER_OVERLAY_LINES);
+    int x_offset = 8;
+    int y_offset = 48;
+    int width = 300;
+    int height = 20 + 14 * lines;
+    graphics_draw_rect(x_offset, y_offset, width + 2, height + 2, COLOR_BLACK);
+    graphics_fill_rect(x_offset + 1, y_offset + 1, width, height, COLOR_WHITE);
+    text_draw(string_from_ascii("Slowest sections, min/avg/max us"), x_offset + 6, y_offset + 6,
+        FONT_SMALL_PLAIN, COLOR_BLACK);
+    for (int i = 0; i < lines; i++) {
+        char line[100];
+        snprintf(line, sizeof(line), "%s: %u/%u/%u", tick_profiler_section_name(stats[i].group, stats[i].section),
+            (unsigned int) stats[i].recent.min_micros, (unsigned int) stats[i].recent.avg_micros,
+            (unsigned int) stats[i].recent.max_micros);
+        uint8_t text[100];
+        encoding_from_utf8(line, text, sizeof(text));
+        text_draw(text, x_offset + 6, y_offset + 20 + 14 * i, FONT_SMALL_PLAIN, COLOR_BLACK);
+    }
+}
+
 void game_exit(void)
 {
+    game_replay_stop();
+    game_file_finish_background_saves();
+    jobs_shutdown();
     video_shutdown();
     settings_save();
     config_save();
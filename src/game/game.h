@@ -5,6 +5,12 @@ int game_pre_init(void);
 
 int game_init(void);
 
+/**
+ * Loads the game data needed to run the simulation without sound or windows
+ * @return 1 on success, 0 on failure
+ */
+int game_init_headless(void);
+
 int game_init_editor(void);
 
 int game_reload_language(void);
@@ -15,6 +21,11 @@ void game_draw(void);
 
 void game_display_fps(int fps);
 
+/**
+ * Draws the slowest tick sections of the last few runs below the FPS counter
+ */
+void game_display_tick_profiler(void);
+
 void game_exit_editor(void);
 
 void game_exit(void);
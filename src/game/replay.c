@@ -0,0 +1,337 @@
+#include "replay.h"
+
+#include "city/view.h"
+#include "core/file.h"
+#include "core/log.h"
+#include "game/file_io.h"
+#include "game/time.h"
+#include "graphics/screen.h"
+#include "input/hotkey.h"
+#include "input/mouse.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define REPLAY_MAGIC "AUGREPLY"
+#define REPLAY_VERSION 1
+#define MAX_PIECES 128
+#define NO_RECORD_READ -2
+
+// Records are written in native byte order: replays are meant to be played back by the same build
+typedef enum {
+    RECORD_TICKS = 'T',
+    RECORD_INPUT = 'I',
+    RECORD_SAME_INPUT = 'S',
+    RECORD_DAY = 'D'
+} record_type;
+
+typedef enum {
+    REPLAY_NONE = 0,
+    REPLAY_RECORDING = 1,
+    REPLAY_PLAYING = 2
+} replay_mode;
+
+typedef struct {
+    char magic[8];
+    int32_t version;
+    int32_t input_size;
+    int32_t screen_width;
+    int32_t screen_height;
+} replay_header;
+
+typedef struct {
+    mouse mouse;
+    hotkeys hotkeys;
+    int camera_x;
+    int camera_y;
+    int scale;
+    int sidebar_collapsed;
+} frame_input;
+
+static struct {
+    replay_mode mode;
+    FILE *fp;
+    int next_record;
+    int has_input;
+    frame_input input;
+    int day;
+    int days_verified;
+    int diverged;
+} data;
+
+static void init(replay_mode mode, FILE *fp)
+{
+    data.mode = mode;
+    data.fp = fp;
+    data.next_record = NO_RECORD_READ;
+    data.has_input = 0;
+    data.day = 0;
+    data.days_verified = 0;
+    data.diverged = 0;
+}
+
+int game_replay_start_recording(const char *filename)
+{
+    game_replay_stop();
+    FILE *fp = file_open(filename, "wb");
+    if (!fp) {
+        log_error("Unable to write replay", filename, 0);
+        return 0;
+    }
+    replay_header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, REPLAY_MAGIC, sizeof(header.magic));
+    header.version = REPLAY_VERSION;
+    header.input_size = sizeof(frame_input);
+    header.screen_width = screen_width();
+    header.screen_height = screen_height();
+    fwrite(&header, sizeof(header), 1, fp);
+
+    init(REPLAY_RECORDING, fp);
+    log_info("Recording replay to", filename, 0);
+    return 1;
+}
+
+int game_replay_start_playback(const char *filename)
+{
+    game_replay_stop();
+    FILE *fp = file_open(filename, "rb");
+    if (!fp) {
+        log_error("Unable to open replay", filename, 0);
+        return 0;
+    }
+    replay_header header;
+    if (fread(&header, sizeof(header), 1, fp) != 1 || memcmp(header.magic, REPLAY_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != REPLAY_VERSION || header.input_size != sizeof(frame_input)) {
+        log_error("Not a replay file or recorded with a different version", filename, 0);
+        file_close(fp);
+        return 0;
+    }
+    if (header.screen_width != screen_width() || header.screen_height != screen_height()) {
+        log_info("Replay was recorded at a different screen size, recorded clicks may not match. Width:",
+            0, header.screen_width);
+    }
+    init(REPLAY_PLAYING, fp);
+    log_info("Playing back replay", filename, 0);
+    return 1;
+}
+
+void game_replay_stop(void)
+{
+    if (data.mode == REPLAY_RECORDING) {
+        log_info("Replay recorded, days:", 0, data.day);
+    } else if (data.mode == REPLAY_PLAYING && !data.diverged) {
+        log_info("Replay finished without divergence, days verified:", 0, data.days_verified);
+    }
+    if (data.fp) {
+        file_close(data.fp);
+        data.fp = 0;
+    }
+    data.mode = REPLAY_NONE;
+}
+
+int game_replay_is_playing(void)
+{
+    return data.mode == REPLAY_PLAYING;
+}
+
+int game_replay_has_diverged(void)
+{
+    return data.diverged;
+}
+
+static int peek_record(void)
+{
+    if (data.next_record == NO_RECORD_READ) {
+        data.next_record = fgetc(data.fp);
+    }
+    return data.next_record;
+}
+
+static void consume_record(void)
+{
+    data.next_record = NO_RECORD_READ;
+}
+
+static void write_record(record_type type, const void *payload, size_t size)
+{
+    fputc(type, data.fp);
+    if (size) {
+        fwrite(payload, size, 1, data.fp);
+    }
+}
+
+static int read_payload(void *payload, size_t size)
+{
+    consume_record();
+    if (fread(payload, size, 1, data.fp) != 1) {
+        log_error("Replay file is truncated", 0, 0);
+        game_replay_stop();
+        return 0;
+    }
+    return 1;
+}
+
+int game_replay_get_ticks_to_run(int elapsed_ticks)
+{
+    if (data.mode == REPLAY_RECORDING) {
+        int32_t ticks = elapsed_ticks;
+        write_record(RECORD_TICKS, &ticks, sizeof(ticks));
+    } else if (data.mode == REPLAY_PLAYING && peek_record() == RECORD_TICKS) {
+        int32_t ticks;
+        if (read_payload(&ticks, sizeof(ticks))) {
+            return ticks;
+        }
+    }
+    return elapsed_ticks;
+}
+
+static void get_current_input(frame_input *input)
+{
+    memset(input, 0, sizeof(frame_input));
+    input->mouse = *mouse_get();
+    input->hotkeys = *hotkey_state();
+    city_view_get_camera_in_pixels(&input->camera_x, &input->camera_y);
+    input->scale = city_view_get_scale();
+    input->sidebar_collapsed = city_view_is_sidebar_collapsed();
+}
+
+static void apply_input(const frame_input *input)
+{
+    mouse_set_state(&input->mouse);
+    hotkey_set_state(&input->hotkeys);
+    if (city_view_is_sidebar_collapsed() != input->sidebar_collapsed) {
+        city_view_toggle_sidebar();
+    }
+    if (city_view_get_scale() != input->scale) {
+        city_view_set_scale(input->scale);
+    }
+    int camera_x, camera_y;
+    city_view_get_camera_in_pixels(&camera_x, &camera_y);
+    if (camera_x != input->camera_x || camera_y != input->camera_y) {
+        city_view_set_camera_from_pixel_position(input->camera_x, input->camera_y);
+    }
+}
+
+void game_replay_handle_input(void)
+{
+    if (data.mode == REPLAY_RECORDING) {
+        frame_input input;
+        get_current_input(&input);
+        if (data.has_input && memcmp(&input, &data.input, sizeof(frame_input)) == 0) {
+            write_record(RECORD_SAME_INPUT, 0, 0);
+        } else {
+            write_record(RECORD_INPUT, &input, sizeof(frame_input));
+            data.input = input;
+            data.has_input = 1;
+        }
+    } else if (data.mode == REPLAY_PLAYING) {
+        int type = peek_record();
+        if (type == RECORD_INPUT) {
+            if (!read_payload(&data.input, sizeof(frame_input))) {
+                return;
+            }
+            data.has_input = 1;
+        } else if (type == RECORD_SAME_INPUT && data.has_input) {
+            consume_record();
+        } else {
+            // Recorded without a window: only the state hashes are verified, the player keeps control
+            return;
+        }
+        apply_input(&data.input);
+    }
+}
+
+static void report_divergence(int piece, uint32_t expected, uint32_t actual)
+{
+    char message[200];
+    snprintf(message, sizeof(message),
+        "Replay diverged on day %d (year %d, month %d, day %d) in savegame piece #%d: expected %08x, got %08x",
+        data.day, game_time_year(), game_time_month() + 1, game_time_day() + 1, piece,
+        (unsigned int) expected, (unsigned int) actual);
+    log_error(message, 0, 0);
+    data.diverged = 1;
+}
+
+static int read_day_record(int32_t *day, uint32_t *hashes)
+{
+    int32_t day_info[2];
+    if (!read_payload(day_info, sizeof(day_info))) {
+        return -1;
+    }
+    int num_pieces = day_info[1];
+    if (num_pieces < 0 || num_pieces > MAX_PIECES ||
+        (num_pieces && !read_payload(hashes, sizeof(uint32_t) * num_pieces))) {
+        log_error("Replay file is corrupt at day", 0, data.day);
+        game_replay_stop();
+        return -1;
+    }
+    *day = day_info[0];
+    return num_pieces;
+}
+
+static void skip_day(void)
+{
+    if (peek_record() == RECORD_DAY) {
+        int32_t day;
+        uint32_t hashes[MAX_PIECES];
+        read_day_record(&day, hashes);
+    }
+}
+
+static void verify_day(const uint32_t *hashes, int num_pieces)
+{
+    int type = peek_record();
+    if (type == EOF) {
+        game_replay_stop();
+        return;
+    }
+    if (type != RECORD_DAY) {
+        log_error("Replay expects player input before the end of day, play it back in a window. Day:", 0, data.day);
+        data.diverged = 1;
+        game_replay_stop();
+        return;
+    }
+    int32_t expected_day;
+    uint32_t expected[MAX_PIECES];
+    int expected_pieces = read_day_record(&expected_day, expected);
+    if (expected_pieces < 0) {
+        return;
+    }
+    if (expected_day != data.day || expected_pieces != num_pieces) {
+        log_error("Replay was recorded with a different savegame layout, day:", 0, expected_day);
+        data.diverged = 1;
+        return;
+    }
+    for (int i = 0; i < num_pieces; i++) {
+        if (expected[i] != hashes[i]) {
+            report_divergence(i, expected[i], hashes[i]);
+        }
+    }
+    if (!data.diverged) {
+        data.days_verified++;
+    }
+}
+
+void game_replay_end_of_day(void)
+{
+    if (data.mode == REPLAY_NONE) {
+        return;
+    }
+    data.day++;
+    if (data.mode == REPLAY_PLAYING && data.diverged) {
+        // Keep the input in sync, there is no point in comparing any further
+        skip_day();
+        return;
+    }
+    uint32_t hashes[MAX_PIECES];
+    int num_pieces = game_file_io_hash_saved_game_state(hashes, MAX_PIECES);
+    if (data.mode == REPLAY_RECORDING) {
+        int32_t day_info[2] = { data.day, num_pieces };
+        write_record(RECORD_DAY, day_info, sizeof(day_info));
+        fwrite(hashes, sizeof(uint32_t), num_pieces, data.fp);
+    } else {
+        verify_day(hashes, num_pieces);
+    }
+}
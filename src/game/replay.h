@@ -0,0 +1,64 @@
+#ifndef GAME_REPLAY_H
+#define GAME_REPLAY_H
+
+/**
+ * @file
+ * Records and plays back a game session to verify that the simulation stays deterministic.
+ *
+ * While recording, the player input of every frame and a hash of each savegame piece at the end
+ * of every day are written to a replay file. While playing back, the recorded input is used instead
+ * of the real input and the hashes are compared, so the first day and piece where the game state
+ * differs from the recording are reported.
+ */
+
+/**
+ * Starts recording to the given file. Should be called right after loading the game to record.
+ * @param filename File to write to
+ * @return 1 on success, 0 if the file could not be opened
+ */
+int game_replay_start_recording(const char *filename);
+
+/**
+ * Starts playing back the given file. Should be called right after loading the same game as was recorded.
+ * @param filename Replay file
+ * @return 1 on success, 0 if the file could not be read
+ */
+int game_replay_start_playback(const char *filename);
+
+/**
+ * Stops recording or playing back and closes the replay file
+ */
+void game_replay_stop(void);
+
+/**
+ * Checks whether a replay is being played back
+ * @return 1 if playing back, 0 otherwise
+ */
+int game_replay_is_playing(void);
+
+/**
+ * Checks whether the game state differed from the recording during playback
+ * @return 1 if a divergence was found, 0 otherwise
+ */
+int game_replay_has_diverged(void);
+
+/**
+ * Gets the number of ticks to run this frame. Records the number while recording,
+ * returns the recorded number while playing back.
+ * @param elapsed_ticks The number of ticks based on the game speed
+ * @return The number of ticks to run
+ */
+int game_replay_get_ticks_to_run(int elapsed_ticks);
+
+/**
+ * Records the mouse, hotkeys and camera of this frame, or replaces them with the recorded ones.
+ * Should be called right before the current window handles input.
+ */
+void game_replay_handle_input(void);
+
+/**
+ * Records or verifies the state hashes. Should be called at the end of every day.
+ */
+void game_replay_end_of_day(void);
+
+#endif // GAME_REPLAY_H
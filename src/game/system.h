@@ -33,6 +33,12 @@ const char *system_OS(void);
  */
 uint64_t system_get_ticks(void);
 
+/**
+ * Gets a high resolution timestamp in microseconds. Use only for time difference calculations.
+ * @return Number of microseconds
+ */
+uint64_t system_get_microseconds(void);
+
 /**
  * Resize window
  * @param width New width
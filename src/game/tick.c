@@ -39,7 +39,9 @@
 #include "figure/formation.h"
 #include "figuretype/crime.h"
 #include "game/file.h"
+#include "game/replay.h"
 #include "game/settings.h"
+#include "game/tick_profiler.h"
 #include "game/time.h"
 #include "game/tutorial.h"
 #include "game/undo.h"
@@ -63,66 +65,131 @@
 #include "sound/music.h"
 #include "widget/minimap.h"
 
+#define RUN_STEP(step, call) \
+    do { \
+        uint64_t step_start = tick_profiler_start(); \
+        call; \
+        tick_profiler_end(TICK_PROFILER_CALENDAR, step, step_start); \
+    } while (0)
+
+// Applies to the whole session and not to the loaded city
+static int autosaves_enabled = 1;
+
+static const char *PHASE_NAMES[TICK_PHASE_MAX] = {
+    "tick 0", "gods moods", "music", "minimap", "emperor", "formations", "natives", "road network",
+    "granary stocks", "plague", "tick 10", "tick 11", "house services", "tick 13", "tick 14", "tick 15",
+    "warehouse stocks", "food stocks", "tick 18", "dock water access", "production", "rome access",
+    "house room", "migration", "evict overcrowded", "labor", "tick 26", "reservoirs and fountains",
+    "water supply", "legions", "minimap", "figure generation", "trade", "entertainment and culture",
+    "treasury", "culture decay", "culture aggregates", "desirability", "building desirability",
+    "house evolution", "building state", "tick 41", "tourists", "burning ruins", "fire and collapse",
+    "criminals", "industry production", "games", "tax collector decay", "culture",
+    "day/month/year", "figures", "scenario events"
+};
+
+static const char *CALENDAR_STEP_NAMES[TICK_CALENDAR_MAX] = {
+    [TICK_CALENDAR_YEAR_TIME] = "year: time",
+    [TICK_CALENDAR_YEAR_EMPIRE_EXPANSION] = "year: empire expansion",
+    [TICK_CALENDAR_YEAR_POPULATION] = "year: population",
+    [TICK_CALENDAR_YEAR_FINANCE] = "year: finance",
+    [TICK_CALENDAR_YEAR_TRADE] = "year: trade amounts",
+    [TICK_CALENDAR_YEAR_FIRE_DIRECTION] = "year: fire direction",
+    [TICK_CALENDAR_YEAR_RATINGS] = "year: ratings",
+    [TICK_CALENDAR_MONTH_MIGRATION] = "month: migration",
+    [TICK_CALENDAR_MONTH_HEALTH] = "month: health",
+    [TICK_CALENDAR_MONTH_RANDOM_EVENTS] = "month: random events",
+    [TICK_CALENDAR_MONTH_FINANCE] = "month: finance",
+    [TICK_CALENDAR_MONTH_FOOD] = "month: food consumption",
+    [TICK_CALENDAR_MONTH_DISTANT_BATTLE] = "month: distant battle",
+    [TICK_CALENDAR_MONTH_INVASIONS] = "month: invasions",
+    [TICK_CALENDAR_MONTH_REQUESTS] = "month: requests",
+    [TICK_CALENDAR_MONTH_DEMAND_CHANGES] = "month: demand changes",
+    [TICK_CALENDAR_MONTH_PRICE_CHANGES] = "month: price changes",
+    [TICK_CALENDAR_MONTH_GOVERN] = "month: months to govern",
+    [TICK_CALENDAR_MONTH_MORALE] = "month: morale",
+    [TICK_CALENDAR_MONTH_MESSAGE_DELAYS] = "month: message delays",
+    [TICK_CALENDAR_MONTH_BLESSING_BOOST] = "month: blessing boost",
+    [TICK_CALENDAR_MONTH_INDUSTRY_STATS] = "month: industry stats",
+    [TICK_CALENDAR_MONTH_STRIKES] = "month: strikes",
+    [TICK_CALENDAR_MONTH_BUILDING_TRIM] = "month: building trim",
+    [TICK_CALENDAR_MONTH_CONNECTIONS] = "month: connectable buildings",
+    [TICK_CALENDAR_MONTH_ROAD_TILES] = "month: road tiles",
+    [TICK_CALENDAR_MONTH_HIGHWAY_TILES] = "month: highway tiles",
+    [TICK_CALENDAR_MONTH_WATER_TILES] = "month: water tiles",
+    [TICK_CALENDAR_MONTH_CITIZEN_ROUTING] = "month: citizen routing",
+    [TICK_CALENDAR_MONTH_MESSAGES] = "month: messages",
+    [TICK_CALENDAR_MONTH_RATINGS] = "month: ratings",
+    [TICK_CALENDAR_MONTH_POPULATION] = "month: population",
+    [TICK_CALENDAR_MONTH_FESTIVAL] = "month: festival",
+    [TICK_CALENDAR_MONTH_GAMES] = "month: games",
+    [TICK_CALENDAR_MONTH_BLESSINGS] = "month: blessings",
+    [TICK_CALENDAR_MONTH_TUTORIAL] = "month: tutorial",
+    [TICK_CALENDAR_MONTH_SCENARIO_EVENTS] = "month: scenario events",
+    [TICK_CALENDAR_MONTH_AUTOSAVE] = "month: autosave",
+    [TICK_CALENDAR_DAY_SENTIMENT] = "day: sentiment",
+    [TICK_CALENDAR_DAY_LIGHTHOUSE] = "day: lighthouse timber"
+};
+
 static void advance_year(void)
 {
-    game_undo_disable();
-    game_time_advance_year();
-    scenario_empire_process_expansion();
-    city_population_request_yearly_update();
-    city_finance_handle_year_change();
-    empire_city_reset_yearly_trade_amounts();
-    building_maintenance_update_fire_direction();
-    city_ratings_update(1,0);
+    RUN_STEP(TICK_CALENDAR_YEAR_TIME, game_undo_disable(); game_time_advance_year());
+    RUN_STEP(TICK_CALENDAR_YEAR_EMPIRE_EXPANSION, scenario_empire_process_expansion());
+    RUN_STEP(TICK_CALENDAR_YEAR_POPULATION, city_population_request_yearly_update());
+    RUN_STEP(TICK_CALENDAR_YEAR_FINANCE, city_finance_handle_year_change());
+    RUN_STEP(TICK_CALENDAR_YEAR_TRADE, empire_city_reset_yearly_trade_amounts());
+    RUN_STEP(TICK_CALENDAR_YEAR_FIRE_DIRECTION, building_maintenance_update_fire_direction());
+    RUN_STEP(TICK_CALENDAR_YEAR_RATINGS, city_ratings_update(1,0));
 }
 
 static void advance_month(void)
 {
     int new_year = 0;
-    city_migration_reset_newcomers();
-    city_health_update();
-    scenario_random_event_process();
-    city_finance_handle_month_change();
-    city_resource_consume_food();
-    scenario_distant_battle_process();
-    scenario_invasion_process();
-    scenario_request_process();
-    scenario_demand_change_process();
-    scenario_price_change_process();
-    city_victory_update_months_to_govern();
-    formation_update_monthly_morale_at_rest();
-    city_message_decrease_delays();
-    city_sentiment_decrement_blessing_boost();
-    building_industry_advance_stats();
-    building_industry_start_strikes();
-    building_trim();
-
-    building_connectable_update_connections();
-    map_tiles_update_all_roads();
-    map_tiles_update_all_highways();
-    map_tiles_update_all_water();
-    map_routing_update_land_citizen();
-    city_message_sort_and_compact();
+    RUN_STEP(TICK_CALENDAR_MONTH_MIGRATION, city_migration_reset_newcomers());
+    RUN_STEP(TICK_CALENDAR_MONTH_HEALTH, city_health_update());
+    RUN_STEP(TICK_CALENDAR_MONTH_RANDOM_EVENTS, scenario_random_event_process());
+    RUN_STEP(TICK_CALENDAR_MONTH_FINANCE, city_finance_handle_month_change());
+    RUN_STEP(TICK_CALENDAR_MONTH_FOOD, city_resource_consume_food());
+    RUN_STEP(TICK_CALENDAR_MONTH_DISTANT_BATTLE, scenario_distant_battle_process());
+    RUN_STEP(TICK_CALENDAR_MONTH_INVASIONS, scenario_invasion_process());
+    RUN_STEP(TICK_CALENDAR_MONTH_REQUESTS, scenario_request_process());
+    RUN_STEP(TICK_CALENDAR_MONTH_DEMAND_CHANGES, scenario_demand_change_process());
+    RUN_STEP(TICK_CALENDAR_MONTH_PRICE_CHANGES, scenario_price_change_process());
+    RUN_STEP(TICK_CALENDAR_MONTH_GOVERN, city_victory_update_months_to_govern());
+    RUN_STEP(TICK_CALENDAR_MONTH_MORALE, formation_update_monthly_morale_at_rest());
+    RUN_STEP(TICK_CALENDAR_MONTH_MESSAGE_DELAYS, city_message_decrease_delays());
+    RUN_STEP(TICK_CALENDAR_MONTH_BLESSING_BOOST, city_sentiment_decrement_blessing_boost());
+    RUN_STEP(TICK_CALENDAR_MONTH_INDUSTRY_STATS, building_industry_advance_stats());
+    RUN_STEP(TICK_CALENDAR_MONTH_STRIKES, building_industry_start_strikes());
+    RUN_STEP(TICK_CALENDAR_MONTH_BUILDING_TRIM, building_trim());
+
+    RUN_STEP(TICK_CALENDAR_MONTH_CONNECTIONS, building_connectable_update_connections());
+    RUN_STEP(TICK_CALENDAR_MONTH_ROAD_TILES, map_tiles_update_all_roads());
+    RUN_STEP(TICK_CALENDAR_MONTH_HIGHWAY_TILES, map_tiles_update_all_highways());
+    RUN_STEP(TICK_CALENDAR_MONTH_WATER_TILES, map_tiles_update_all_water());
+    RUN_STEP(TICK_CALENDAR_MONTH_CITIZEN_ROUTING, map_routing_update_land_citizen());
+    RUN_STEP(TICK_CALENDAR_MONTH_MESSAGES, city_message_sort_and_compact());
 
     if (game_time_advance_month()) {
         advance_year();
         new_year = 1;
     } else {
-        city_ratings_update(0,1);
+        RUN_STEP(TICK_CALENDAR_MONTH_RATINGS, city_ratings_update(0,1));
     }
 
-    city_population_record_monthly();
-    city_festival_update();
-    city_games_decrement_month_counts();
-    city_gods_update_blessings();
-    tutorial_on_month_tick();
-    scenario_events_progress_paused(1);
-    scenario_events_process_all();
-    if (setting_monthly_autosave()) {
-        game_file_write_saved_game(dir_append_location("autosave.svx", PATH_LOCATION_SAVEGAME));
+    RUN_STEP(TICK_CALENDAR_MONTH_POPULATION, city_population_record_monthly());
+    RUN_STEP(TICK_CALENDAR_MONTH_FESTIVAL, city_festival_update());
+    RUN_STEP(TICK_CALENDAR_MONTH_GAMES, city_games_decrement_month_counts());
+    RUN_STEP(TICK_CALENDAR_MONTH_BLESSINGS, city_gods_update_blessings());
+    RUN_STEP(TICK_CALENDAR_MONTH_TUTORIAL, tutorial_on_month_tick());
+    RUN_STEP(TICK_CALENDAR_MONTH_SCENARIO_EVENTS, scenario_events_progress_paused(1); scenario_events_process_all());
+    uint64_t autosave_start = tick_profiler_start();
+    if (autosaves_enabled && setting_monthly_autosave()) {
+        game_file_write_saved_game_in_background(dir_append_location("autosave.svx", PATH_LOCATION_SAVEGAME));
     }
-    if (new_year && config_get(CONFIG_GP_CH_YEARLY_AUTOSAVE)) {
-        game_file_write_saved_game(dir_append_location("autosave-year.svx", PATH_LOCATION_SAVEGAME));
+    if (autosaves_enabled && new_year && config_get(CONFIG_GP_CH_YEARLY_AUTOSAVE)) {
+        game_file_write_saved_game_in_background(dir_append_location("autosave-year.svx", PATH_LOCATION_SAVEGAME));
     }
+    tick_profiler_end(TICK_PROFILER_CALENDAR, TICK_CALENDAR_MONTH_AUTOSAVE, autosave_start);
 }
 
 static void advance_day(void)
@@ -131,20 +198,22 @@ static void advance_day(void)
         advance_month();
     }
     if (game_time_day() == 0 || game_time_day() == 8) {
-        city_sentiment_update();
+        RUN_STEP(TICK_CALENDAR_DAY_SENTIMENT, city_sentiment_update());
     }
     if (game_time_day() == 0 || game_time_day() == 7) {
-        building_lighthouse_consume_timber();
+        RUN_STEP(TICK_CALENDAR_DAY_LIGHTHOUSE, building_lighthouse_consume_timber());
     }
     tutorial_on_day_tick();
 }
 
 static void advance_tick(void)
 {
+    int tick = game_time_tick();
+    uint64_t start = tick_profiler_start();
     // NB: these ticks are noop:
     // 0, 10, 11, 13, 14, 15, 18, 26, 41
     // max is 49
-    switch (game_time_tick()) {
+    switch (tick) {
         case 1: city_gods_calculate_moods(1); break;
         case 2: sound_music_update(0); break;
         case 3: widget_minimap_invalidate(); break;
@@ -187,9 +256,13 @@ static void advance_tick(void)
         case 48: house_service_decay_tax_collector(); break;
         case 49: city_culture_calculate(); break;
     }
+    tick_profiler_end(TICK_PROFILER_PHASE, TICK_PHASE_SLOT_0 + tick, start);
+
+    start = tick_profiler_start();
     if (game_time_advance_tick()) {
         advance_day();
     }
+    tick_profiler_end(TICK_PROFILER_PHASE, TICK_PHASE_CALENDAR, start);
 }
 
 void game_tick_run(void)
@@ -202,14 +275,39 @@ void game_tick_run(void)
     random_generate_next();
     game_undo_reduce_time_available();
     advance_tick();
+
+    uint64_t start = tick_profiler_start();
     figure_action_handle();
+    tick_profiler_end(TICK_PROFILER_PHASE, TICK_PHASE_FIGURES, start);
+
+    start = tick_profiler_start();
     scenario_earthquake_process();
     scenario_gladiator_revolt_process();
     scenario_emperor_change_process();
     city_victory_check();
+    tick_profiler_end(TICK_PROFILER_PHASE, TICK_PHASE_SCENARIO, start);
+
+    if (game_time_tick() == 0) {
+        game_replay_end_of_day();
+    }
+}
+
+void game_tick_set_autosaves_enabled(int enabled)
+{
+    autosaves_enabled = enabled;
 }
 
 void game_tick_cheat_year(void)
 {
     advance_year();
 }
+
+const char *game_tick_phase_name(tick_phase phase)
+{
+    return PHASE_NAMES[phase];
+}
+
+const char *game_tick_calendar_step_name(tick_calendar_step step)
+{
+    return CALENDAR_STEP_NAMES[step];
+}
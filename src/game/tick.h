@@ -1,8 +1,87 @@
 #ifndef GAME_TICK_H
 #define GAME_TICK_H
 
+/**
+ * @file
+ * Runs the simulation one tick at a time
+ */
+
+#define TICK_PHASE_SLOTS 50
+
+typedef enum {
+    TICK_PHASE_SLOT_0 = 0, /**< One phase per tick of the day, TICK_PHASE_SLOT_0 + game_time_tick() */
+    TICK_PHASE_CALENDAR = TICK_PHASE_SLOTS, /**< Advancing the day, month and year */
+    TICK_PHASE_FIGURES, /**< Figure actions */
+    TICK_PHASE_SCENARIO, /**< Earthquakes, revolts, emperor changes and victory checks */
+    TICK_PHASE_MAX
+} tick_phase;
+
+typedef enum {
+    TICK_CALENDAR_YEAR_TIME,
+    TICK_CALENDAR_YEAR_EMPIRE_EXPANSION,
+    TICK_CALENDAR_YEAR_POPULATION,
+    TICK_CALENDAR_YEAR_FINANCE,
+    TICK_CALENDAR_YEAR_TRADE,
+    TICK_CALENDAR_YEAR_FIRE_DIRECTION,
+    TICK_CALENDAR_YEAR_RATINGS,
+    TICK_CALENDAR_MONTH_MIGRATION,
+    TICK_CALENDAR_MONTH_HEALTH,
+    TICK_CALENDAR_MONTH_RANDOM_EVENTS,
+    TICK_CALENDAR_MONTH_FINANCE,
+    TICK_CALENDAR_MONTH_FOOD,
+    TICK_CALENDAR_MONTH_DISTANT_BATTLE,
+    TICK_CALENDAR_MONTH_INVASIONS,
+    TICK_CALENDAR_MONTH_REQUESTS,
+    TICK_CALENDAR_MONTH_DEMAND_CHANGES,
+    TICK_CALENDAR_MONTH_PRICE_CHANGES,
+    TICK_CALENDAR_MONTH_GOVERN,
+    TICK_CALENDAR_MONTH_MORALE,
+    TICK_CALENDAR_MONTH_MESSAGE_DELAYS,
+    TICK_CALENDAR_MONTH_BLESSING_BOOST,
+    TICK_CALENDAR_MONTH_INDUSTRY_STATS,
+    TICK_CALENDAR_MONTH_STRIKES,
+    TICK_CALENDAR_MONTH_BUILDING_TRIM,
+    TICK_CALENDAR_MONTH_CONNECTIONS,
+    TICK_CALENDAR_MONTH_ROAD_TILES,
+    TICK_CALENDAR_MONTH_HIGHWAY_TILES,
+    TICK_CALENDAR_MONTH_WATER_TILES,
+    TICK_CALENDAR_MONTH_CITIZEN_ROUTING,
+    TICK_CALENDAR_MONTH_MESSAGES,
+    TICK_CALENDAR_MONTH_RATINGS,
+    TICK_CALENDAR_MONTH_POPULATION,
+    TICK_CALENDAR_MONTH_FESTIVAL,
+    TICK_CALENDAR_MONTH_GAMES,
+    TICK_CALENDAR_MONTH_BLESSINGS,
+    TICK_CALENDAR_MONTH_TUTORIAL,
+    TICK_CALENDAR_MONTH_SCENARIO_EVENTS,
+    TICK_CALENDAR_MONTH_AUTOSAVE,
+    TICK_CALENDAR_DAY_SENTIMENT,
+    TICK_CALENDAR_DAY_LIGHTHOUSE,
+    TICK_CALENDAR_MAX
+} tick_calendar_step;
+
 void game_tick_run(void);
 
+/**
+ * Turns the monthly and yearly autosaves on or off for the rest of the session, regardless of the settings
+ * @param enabled Whether autosaves are written
+ */
+void game_tick_set_autosaves_enabled(int enabled);
+
 void game_tick_cheat_year(void);
 
+/**
+ * Gets a short description of what runs in a tick phase
+ * @param phase The phase
+ * @return Phase name
+ */
+const char *game_tick_phase_name(tick_phase phase);
+
+/**
+ * Gets a short description of a day, month or year step
+ * @param step The step
+ * @return Step name
+ */
+const char *game_tick_calendar_step_name(tick_calendar_step step);
+
 #endif // GAME_TICK_H
@@ -0,0 +1,219 @@
+#include "tick_profiler.h"
+
+#include "core/encoding.h"
+#include "core/file.h"
+#include "core/lang.h"
+#include "core/log.h"
+#include "figure/type.h"
+#include "game/system.h"
+#include "game/tick.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define MAX_SECTIONS (TICK_PHASE_MAX + TICK_CALENDAR_MAX + FIGURE_TYPE_MAX)
+
+typedef struct {
+    uint64_t total_micros;
+    uint32_t max_micros;
+    int count;
+    uint32_t recent[TICK_PROFILER_RECENT_RUNS];
+    int recent_index;
+    int recent_count;
+    uint64_t pending_micros;
+    int has_pending;
+} section_data;
+
+static const int GROUP_SIZES[TICK_PROFILER_GROUP_MAX] = {
+    TICK_PHASE_MAX, TICK_CALENDAR_MAX, FIGURE_TYPE_MAX
+};
+
+static const char *GROUP_NAMES[TICK_PROFILER_GROUP_MAX] = {
+    "phase", "calendar", "figure"
+};
+
+static struct {
+    int enabled;
+    section_data sections[MAX_SECTIONS];
+} data;
+
+static section_data *get_section(tick_profiler_group group, int section)
+{
+    int index = section;
+    for (int i = 0; i < group; i++) {
+        index += GROUP_SIZES[i];
+    }
+    return &data.sections[index];
+}
+
+static void add_run(section_data *s, uint64_t micros)
+{
+    uint32_t duration = micros > UINT32_MAX ? UINT32_MAX : (uint32_t) micros;
+    s->total_micros += micros;
+    if (duration > s->max_micros) {
+        s->max_micros = duration;
+    }
+    s->count++;
+    s->recent[s->recent_index] = duration;
+    s->recent_index = (s->recent_index + 1) % TICK_PROFILER_RECENT_RUNS;
+    if (s->recent_count < TICK_PROFILER_RECENT_RUNS) {
+        s->recent_count++;
+    }
+}
+
+void tick_profiler_set_enabled(int enabled)
+{
+    data.enabled = enabled;
+}
+
+int tick_profiler_is_enabled(void)
+{
+    return data.enabled;
+}
+
+void tick_profiler_reset(void)
+{
+    memset(data.sections, 0, sizeof(data.sections));
+}
+
+uint64_t tick_profiler_start(void)
+{
+    return data.enabled ? system_get_microseconds() : 0;
+}
+
+void tick_profiler_end(tick_profiler_group group, int section, uint64_t start)
+{
+    if (!data.enabled || !start) {
+        return;
+    }
+    add_run(get_section(group, section), system_get_microseconds() - start);
+}
+
+void tick_profiler_accumulate(tick_profiler_group group, int section, uint64_t start)
+{
+    if (!data.enabled || !start) {
+        return;
+    }
+    section_data *s = get_section(group, section);
+    s->pending_micros += system_get_microseconds() - start;
+    s->has_pending = 1;
+}
+
+void tick_profiler_commit(tick_profiler_group group)
+{
+    section_data *s = get_section(group, 0);
+    for (int i = 0; i < GROUP_SIZES[group]; i++, s++) {
+        if (s->has_pending) {
+            add_run(s, s->pending_micros);
+            s->pending_micros = 0;
+            s->has_pending = 0;
+        }
+    }
+}
+
+int tick_profiler_num_sections(tick_profiler_group group)
+{
+    return GROUP_SIZES[group];
+}
+
+const char *tick_profiler_section_name(tick_profiler_group group, int section)
+{
+    static char name[100];
+    switch (group) {
+        case TICK_PROFILER_PHASE:
+            return game_tick_phase_name(section);
+        case TICK_PROFILER_CALENDAR:
+            return game_tick_calendar_step_name(section);
+        default:
+            encoding_to_utf8(lang_get_figure_type_string(section), name, sizeof(name), 0);
+            if (!*name) {
+                snprintf(name, sizeof(name), "figure type %d", section);
+            }
+            return name;
+    }
+}
+
+void tick_profiler_get_stats(tick_profiler_group group, int section, tick_profiler_stats *stats)
+{
+    const section_data *s = get_section(group, section);
+    memset(stats, 0, sizeof(tick_profiler_stats));
+    stats->group = group;
+    stats->section = section;
+    stats->total_micros = s->total_micros;
+    stats->max_micros = s->max_micros;
+    stats->count = s->count;
+    if (!s->recent_count) {
+        return;
+    }
+    uint64_t recent_total = 0;
+    stats->recent.min_micros = UINT32_MAX;
+    for (int i = 0; i < s->recent_count; i++) {
+        uint32_t duration = s->recent[i];
+        recent_total += duration;
+        if (duration < stats->recent.min_micros) {
+            stats->recent.min_micros = duration;
+        }
+        if (duration > stats->recent.max_micros) {
+            stats->recent.max_micros = duration;
+        }
+    }
+    stats->recent.avg_micros = (uint32_t) (recent_total / s->recent_count);
+    stats->recent.count = s->recent_count;
+}
+
+int tick_profiler_get_slowest(tick_profiler_stats *stats, int max_sections)
+{
+    int num_stats = 0;
+    for (tick_profiler_group group = 0; group < TICK_PROFILER_GROUP_MAX; group++) {
+        for (int section = 0; section < GROUP_SIZES[group]; section++) {
+            tick_profiler_stats current;
+            tick_profiler_get_stats(group, section, &current);
+            if (!current.recent.count) {
+                continue;
+            }
+            // Insertion into the sorted list, dropping the fastest one when full
+            int index = num_stats;
+            while (index > 0 && stats[index - 1].recent.max_micros < current.recent.max_micros) {
+                if (index < max_sections) {
+                    stats[index] = stats[index - 1];
+                }
+                index--;
+            }
+            if (index < max_sections) {
+                stats[index] = current;
+                if (num_stats < max_sections) {
+                    num_stats++;
+                }
+            }
+        }
+    }
+    return num_stats;
+}
+
+int tick_profiler_save_csv(const char *filename)
+{
+    FILE *fp = file_open(filename, "w");
+    if (!fp) {
+        log_error("Unable to write tick profile", filename, 0);
+        return 0;
+    }
+    fprintf(fp, "group,section,name,runs,total_us,avg_us,max_us,recent_runs,recent_min_us,recent_avg_us,"
+        "recent_max_us\n");
+    for (tick_profiler_group group = 0; group < TICK_PROFILER_GROUP_MAX; group++) {
+        for (int section = 0; section < GROUP_SIZES[group]; section++) {
+            tick_profiler_stats stats;
+            tick_profiler_get_stats(group, section, &stats);
+            if (!stats.count) {
+                continue;
+            }
+            fprintf(fp, "%s,%d,\"%s\",%d,%llu,%llu,%u,%d,%u,%u,%u\n", GROUP_NAMES[group], section,
+                tick_profiler_section_name(group, section), stats.count,
+                (unsigned long long) stats.total_micros, (unsigned long long) (stats.total_micros / stats.count),
+                (unsigned int) stats.max_micros, stats.recent.count, (unsigned int) stats.recent.min_micros,
+                (unsigned int) stats.recent.avg_micros, (unsigned int) stats.recent.max_micros);
+        }
+    }
+    file_close(fp);
+    log_info("Tick profile saved to", filename, 0);
+    return 1;
+}
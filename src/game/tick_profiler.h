@@ -0,0 +1,120 @@
+#ifndef GAME_TICK_PROFILER_H
+#define GAME_TICK_PROFILER_H
+
+#include <stdint.h>
+
+/**
+ * @file
+ * Measures how long each part of the simulation takes
+ */
+
+/**
+ * Number of recent runs of a section that are kept for the rolling statistics
+ */
+#define TICK_PROFILER_RECENT_RUNS 64
+
+typedef enum {
+    TICK_PROFILER_PHASE = 0, /**< Sections are tick_phase values */
+    TICK_PROFILER_CALENDAR = 1, /**< Sections are tick_calendar_step values */
+    TICK_PROFILER_FIGURE = 2, /**< Sections are figure types, summed over all figures of a tick */
+    TICK_PROFILER_GROUP_MAX
+} tick_profiler_group;
+
+typedef struct {
+    tick_profiler_group group;
+    int section;
+    uint64_t total_micros;
+    uint32_t max_micros;
+    int count;
+    struct {
+        uint32_t min_micros;
+        uint32_t avg_micros;
+        uint32_t max_micros;
+        int count;
+    } recent;
+} tick_profiler_stats;
+
+/**
+ * Enables or disables measuring
+ * @param enabled Whether to measure
+ */
+void tick_profiler_set_enabled(int enabled);
+
+/**
+ * Checks whether measuring is enabled
+ * @return 1 if enabled, 0 otherwise
+ */
+int tick_profiler_is_enabled(void);
+
+/**
+ * Clears all measurements
+ */
+void tick_profiler_reset(void);
+
+/**
+ * Starts measuring a section
+ * @return Start time to pass to tick_profiler_end or tick_profiler_accumulate, 0 when disabled
+ */
+uint64_t tick_profiler_start(void);
+
+/**
+ * Records one run of a section
+ * @param group Section group
+ * @param section Section within the group
+ * @param start Value returned by tick_profiler_start
+ */
+void tick_profiler_end(tick_profiler_group group, int section, uint64_t start);
+
+/**
+ * Adds time to a section without finishing the run, for sections that run many times per tick
+ * @param group Section group
+ * @param section Section within the group
+ * @param start Value returned by tick_profiler_start
+ */
+void tick_profiler_accumulate(tick_profiler_group group, int section, uint64_t start);
+
+/**
+ * Records the accumulated time of each section of the group as one run
+ * @param group Section group
+ */
+void tick_profiler_commit(tick_profiler_group group);
+
+/**
+ * Gets the number of sections of a group
+ * @param group Section group
+ * @return Number of sections
+ */
+int tick_profiler_num_sections(tick_profiler_group group);
+
+/**
+ * Gets the name of a section
+ * @param group Section group
+ * @param section Section within the group
+ * @return Section name, UTF-8 encoded and valid until the next call
+ */
+const char *tick_profiler_section_name(tick_profiler_group group, int section);
+
+/**
+ * Gets the measurements of a section
+ * @param group Section group
+ * @param section Section within the group
+ * @param stats Output measurements
+ */
+void tick_profiler_get_stats(tick_profiler_group group, int section, tick_profiler_stats *stats);
+
+/**
+ * Gets the sections with the slowest recent runs
+ * @param stats Output measurements, sorted by the slowest recent run
+ * @param max_sections Maximum number of sections to return
+ * @return Number of sections returned
+ */
+int tick_profiler_get_slowest(tick_profiler_stats *stats, int max_sections);
+
+/**
+ * Writes all measurements to a CSV file
+ * @param filename File to write
+ * @return 1 on success, 0 on failure
+ */
+int tick_profiler_save_csv(const char *filename);
+
+#endif // GAME_TICK_PROFILER_H
@@ -145,7 +145,7 @@ void game_undo_restore_building_state(void)
         if (data.buildings[i].id) {
             building *b = building_get(data.buildings[i].id);
             if (b->state == BUILDING_STATE_DELETED_BY_PLAYER) {
-                b->state = BUILDING_STATE_IN_USE;
+                building_set_state(b, BUILDING_STATE_IN_USE);
             }
             b->is_deleted = 0;
         }
@@ -203,7 +203,7 @@ static void add_building_to_terrain(building *b)
             b->data.industry.fishing_boat_id = 0;
         }
     }
-    b->state = BUILDING_STATE_IN_USE;
+    building_set_state(b, BUILDING_STATE_IN_USE);
 }
 
 void game_undo_perform(void)
@@ -270,7 +270,7 @@ void game_undo_perform(void)
         }
         for (int i = 0; i < data.num_buildings; i++) {
             if (data.buildings[i].id) {
-                building_get(data.buildings[i].id)->state = BUILDING_STATE_UNDO;
+                building_set_state(building_get(data.buildings[i].id), BUILDING_STATE_UNDO);
             }
         }
         building_update_state();
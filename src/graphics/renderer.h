@@ -80,6 +80,11 @@ typedef struct {
     void (*draw_image_to_screen)(int image_id, int x, int y);
     int (*save_screen_buffer)(color_t *pixels, int x, int y, int width, int height, int row_width);
 
+    int (*start_layer_creation)(int layer_id, int width, int height);
+    void (*finish_layer_creation)(void);
+    int (*draw_layer)(int layer_id, int x, int y, float scale);
+    void (*free_layer)(int layer_id);
+
     void (*get_max_image_size)(int *width, int *height);
 
     const image_atlas_data *(*prepare_image_atlas)(atlas_type type, int num_images, int last_width, int last_height);
@@ -1,5 +1,6 @@
 #include "window.h"
 
+#include "game/replay.h"
 #include "game/system.h"
 #include "graphics/graphics.h"
 #include "graphics/warning.h"
@@ -140,6 +141,7 @@ void window_draw(int force)
     }
     w->draw_foreground();
 
+    game_replay_handle_input();
     const mouse *m = mouse_get();
     const hotkeys *h = hotkey_state();
     w->handle_input(m, h);
@@ -2,9 +2,12 @@
 
 #include "building/type.h"
 #include "city/constants.h"
+#include "core/dir.h"
+#include "core/file.h"
 #include "game/settings.h"
 #include "game/state.h"
 #include "game/system.h"
+#include "game/tick_profiler.h"
 #include "graphics/screenshot.h"
 #include "graphics/video.h"
 #include "graphics/window.h"
@@ -14,6 +17,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 typedef struct {
     int *action;
@@ -35,6 +39,8 @@ typedef struct {
     int save_screenshot;
     int save_city_screenshot;
     int save_minimap_screenshot;
+    int toggle_tick_profiler;
+    int save_tick_profile;
 } global_hotkeys;
 
 static struct {
@@ -233,6 +239,12 @@ static void set_definition_for_action(hotkey_action action, hotkey_definition *d
         case HOTKEY_SAVE_MINIMAP_SCREENSHOT:
             def->action = &data.global_hotkey_state.save_minimap_screenshot;
             break;
+        case HOTKEY_TOGGLE_TICK_PROFILER:
+            def->action = &data.global_hotkey_state.toggle_tick_profiler;
+            break;
+        case HOTKEY_SAVE_TICK_PROFILE:
+            def->action = &data.global_hotkey_state.save_tick_profile;
+            break;
         case HOTKEY_BUILD_VACANT_HOUSE:
             def->action = &data.hotkey_state.building;
             def->value = BUILDING_HOUSE_VACANT_LOT;
@@ -561,6 +573,11 @@ const hotkeys *hotkey_state(void)
     return &data.hotkey_state;
 }
 
+void hotkey_set_state(const hotkeys *state)
+{
+    data.hotkey_state = *state;
+}
+
 void hotkey_reset_state(void)
 {
     memset(&data.hotkey_state, 0, sizeof(data.hotkey_state));
@@ -638,6 +655,15 @@ void hotkey_handle_escape(void)
     window_popup_dialog_show(POPUP_DIALOG_QUIT, confirm_exit, 1);
 }
 
+static void save_tick_profile(void)
+{
+    char filename[FILE_NAME_MAX];
+    time_t curtime = time(NULL);
+    struct tm *loctime = localtime(&curtime);
+    strftime(filename, FILE_NAME_MAX, "tick profile %Y-%m-%d %H.%M.%S.csv", loctime);
+    tick_profiler_save_csv(dir_append_location(filename, PATH_LOCATION_ROOT));
+}
+
 void hotkey_handle_global_keys(void)
 {
     if (data.global_hotkey_state.center_screen) {
@@ -662,6 +688,14 @@ void hotkey_handle_global_keys(void)
     if (data.global_hotkey_state.save_minimap_screenshot) {
         graphics_save_screenshot(SCREENSHOT_MINIMAP);
     }
+    if (data.global_hotkey_state.toggle_tick_profiler) {
+        int enabled = !tick_profiler_is_enabled();
+        tick_profiler_reset();
+        tick_profiler_set_enabled(enabled);
+    }
+    if (data.global_hotkey_state.save_tick_profile) {
+        save_tick_profile();
+    }
 }
 
 void hotkey_set_value_for_action(hotkey_action action, int value)
@@ -47,6 +47,13 @@ typedef struct {
 void hotkey_install_mapping(hotkey_mapping *mappings, int num_mappings);
 
 const hotkeys *hotkey_state(void);
+
+/**
+ * Replaces the hotkey state of this cycle, used to play back recorded input
+ * @param state The state to use
+ */
+void hotkey_set_state(const hotkeys *state);
+
 void hotkey_reset_state(void);
 
 void hotkey_key_pressed(key_type key, key_modifier_type modifiers, int repeat);
@@ -64,6 +64,11 @@ void mouse_remove_touch(void)
     data.is_touch = 0;
 }
 
+void mouse_set_state(const mouse *state)
+{
+    data = *state;
+}
+
 void mouse_set_position(int x, int y)
 {
     if (x != data.x || y != data.y) {
@@ -73,6 +73,12 @@ void mouse_set_from_touch(const touch *first, const touch *last);
  */
 void mouse_remove_touch(void);
 
+/**
+ * Replaces the whole mouse state, used to play back recorded input
+ * @param state The state to use
+ */
+void mouse_set_state(const mouse *state);
+
 void mouse_reset_up_state(void);
 
 void mouse_reset_scroll(void);
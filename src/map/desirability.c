@@ -4,17 +4,81 @@
 #include "building/model.h"
 #include "building/monument.h"
 #include "core/calc.h"
+#include "core/log.h"
 #include "map/data.h"
 #include "map/grid.h"
 #include "map/property.h"
 #include "map/ring.h"
 #include "map/terrain.h"
 
+#include <stdlib.h>
+#include <string.h>
+
+// Set to 1 to compare every incremental update against a full rebuild
+#define VERIFY_INCREMENTAL_UPDATES 0
+
+#define MAX_RANGE 6
+#define MIN_DESIRABILITY -100
+#define MAX_DESIRABILITY 100
+
+#define TERRAIN_SOURCE_KEY_OFFSET 0x1000000
+
+#define BUCKET_SIZE 8
+#define BUCKETS_PER_ROW ((GRID_SIZE + BUCKET_SIZE - 1) / BUCKET_SIZE)
+#define MAX_SOURCES_PER_TILE 1024
+
+typedef struct {
+    int key; // building id, or offset by TERRAIN_SOURCE_KEY_OFFSET for terrain: keeps the order of a full rebuild
+    short x;
+    short y;
+    short size;
+    short value;
+    short step;
+    short step_size;
+    short range;
+} desirability_source;
+
+typedef struct {
+    desirability_source *items;
+    int count;
+    int capacity;
+} source_list;
+
+typedef struct {
+    int grid_offset;
+    short x;
+    short y;
+} changed_tile;
+
 static grid_i8 desirability_grid;
 
+// Sources are re-applied only when they change. Because each addition is clamped to [-100, 100],
+// the sum of contributions is only the real value when no partial sum can leave that range, which is
+// guaranteed when the positive and negative contributions of a tile stay within it. Otherwise the tile
+// is recalculated by replaying its sources in the original order.
+static struct {
+    int is_valid;
+    source_list lists[2];
+    int current;
+    int sum[GRID_SIZE * GRID_SIZE];
+    int positive[GRID_SIZE * GRID_SIZE];
+    int negative[GRID_SIZE * GRID_SIZE];
+    grid_u8 is_changed;
+    changed_tile changed[GRID_SIZE * GRID_SIZE];
+    int num_changed;
+    struct {
+        int is_valid;
+        int max_size;
+        int start[BUCKETS_PER_ROW * BUCKETS_PER_ROW + 1];
+        int *items;
+        int capacity;
+    } buckets;
+} incremental;
+
 void map_desirability_clear(void)
 {
     map_grid_clear_i8(desirability_grid.items);
+    incremental.is_valid = 0;
 }
 
 static void add_desirability_at_distance(int x, int y, int size, int distance, int desirability)
@@ -68,6 +132,30 @@ static void add_to_terrain(int x, int y, int size, int desirability, int step, i
     }
 }
 
+static void add_source(int key, int x, int y, int size, int value, int step, int step_size, int range)
+{
+    source_list *list = &incremental.lists[incremental.current];
+    if (list->count >= list->capacity) {
+        int new_capacity = list->capacity ? list->capacity * 2 : 1024;
+        desirability_source *new_items = realloc(list->items, sizeof(desirability_source) * new_capacity);
+        if (!new_items) {
+            log_error("Unable to allocate desirability sources, the desirability will be wrong", 0, 0);
+            return;
+        }
+        list->items = new_items;
+        list->capacity = new_capacity;
+    }
+    desirability_source *source = &list->items[list->count++];
+    source->key = key;
+    source->x = x;
+    source->y = y;
+    source->size = size;
+    source->value = value;
+    source->step = step;
+    source->step_size = step_size;
+    source->range = range;
+}
+
 static void update_buildings(void)
 {
     int value;
@@ -120,7 +208,7 @@ static void update_buildings(void)
                 range += 1;
             }
 
-            add_to_terrain(
+            add_source(i,
                 b->x, b->y, b->size,
                 value,
                 step,
@@ -130,7 +218,7 @@ static void update_buildings(void)
     }
 }
 
-static void add_garden_desirability(int x, int y)
+static void add_garden_desirability(int grid_offset, int x, int y)
 {
     const model_building *model = model_get_building(BUILDING_GARDENS);
 
@@ -146,7 +234,7 @@ static void add_garden_desirability(int x, int y)
         range += 1;
     }
 
-    add_to_terrain(x, y, 1, value, step, step_size, range);
+    add_source(TERRAIN_SOURCE_KEY_OFFSET + grid_offset, x, y, 1, value, step, step_size, range);
 }
 
 static void update_terrain(void)
@@ -163,7 +251,7 @@ static void update_terrain(void)
                     // earthquake fault line: slight negative
                     type = BUILDING_HOUSE_VACANT_LOT;
                 } else if (terrain & TERRAIN_GARDEN) {
-                    add_garden_desirability(x, y);
+                    add_garden_desirability(grid_offset, x, y);
                     continue;
                 } else {
                     // invalid plaza/earthquake flag
@@ -171,18 +259,18 @@ static void update_terrain(void)
                     continue;
                 }
                 const model_building *model = model_get_building(type);
-                add_to_terrain(x, y, 1,
+                add_source(TERRAIN_SOURCE_KEY_OFFSET + grid_offset, x, y, 1,
                     model->desirability_value,
                     model->desirability_step,
                     model->desirability_step_size,
                     model->desirability_range);
             } else if (terrain & TERRAIN_GARDEN) {
-                add_garden_desirability(x, y);
+                add_garden_desirability(grid_offset, x, y);
             } else if (terrain & TERRAIN_RUBBLE) {
-                add_to_terrain(x, y, 1, -2, 1, 1, 2);
+                add_source(TERRAIN_SOURCE_KEY_OFFSET + grid_offset, x, y, 1, -2, 1, 1, 2);
             } else if (terrain & TERRAIN_HIGHWAY) {
                 const model_building *model = model_get_building(BUILDING_HIGHWAY);
-                add_to_terrain(x, y, 1,
+                add_source(TERRAIN_SOURCE_KEY_OFFSET + grid_offset, x, y, 1,
                     model->desirability_value,
                     model->desirability_step,
                     model->desirability_step_size,
@@ -192,13 +280,297 @@ static void update_terrain(void)
     }
 }
 
-void map_desirability_update(void)
+static void collect_sources(void)
 {
-    map_desirability_clear();
+    incremental.current ^= 1;
+    incremental.lists[incremental.current].count = 0;
     update_buildings();
     update_terrain();
 }
 
+static void rebuild_full(const source_list *sources)
+{
+    map_grid_clear_i8(desirability_grid.items);
+    for (int i = 0; i < sources->count; i++) {
+        const desirability_source *s = &sources->items[i];
+        add_to_terrain(s->x, s->y, s->size, s->value, s->step, s->step_size, s->range);
+    }
+}
+
+static int is_same_source(const desirability_source *a, const desirability_source *b)
+{
+    return a->x == b->x && a->y == b->y && a->size == b->size && a->value == b->value &&
+        a->step == b->step && a->step_size == b->step_size && a->range == b->range;
+}
+
+static void mark_changed(int grid_offset, int x, int y)
+{
+    if (!incremental.is_changed.items[grid_offset]) {
+        incremental.is_changed.items[grid_offset] = 1;
+        changed_tile *tile = &incremental.changed[incremental.num_changed++];
+        tile->grid_offset = grid_offset;
+        tile->x = x;
+        tile->y = y;
+    }
+}
+
+static void add_to_sum(int grid_offset, int desirability)
+{
+    incremental.sum[grid_offset] += desirability;
+    if (desirability > 0) {
+        incremental.positive[grid_offset] += desirability;
+    } else {
+        incremental.negative[grid_offset] += desirability;
+    }
+}
+
+// Same tiles and values as add_to_terrain, into the unclamped sums
+static void apply_source(const desirability_source *s, int sign)
+{
+    if (s->size <= 0) {
+        return;
+    }
+    int range = s->range > MAX_RANGE ? MAX_RANGE : s->range;
+    int desirability = s->value;
+    int tiles_within_step = 0;
+    int base_offset = map_grid_offset(s->x, s->y);
+    for (int distance = 1; distance <= range; distance++) {
+        int start = map_ring_start(s->size, distance);
+        int end = map_ring_end(s->size, distance);
+        for (int i = start; i < end; i++) {
+            const ring_tile *tile = map_ring_tile(i);
+            int x = s->x + tile->x;
+            int y = s->y + tile->y;
+            if (!map_ring_is_inside_map(x, y)) {
+                continue;
+            }
+            int grid_offset = base_offset + tile->grid_offset;
+            if (desirability) {
+                add_to_sum(grid_offset, sign * desirability);
+            }
+            mark_changed(grid_offset, x, y);
+        }
+        tiles_within_step++;
+        if (tiles_within_step >= s->step) {
+            desirability += s->step_size;
+            tiles_within_step = 0;
+        }
+    }
+}
+
+static void apply_changed_sources(const source_list *old_sources, const source_list *new_sources)
+{
+    int old_index = 0;
+    int new_index = 0;
+    while (old_index < old_sources->count || new_index < new_sources->count) {
+        const desirability_source *old_source = old_index < old_sources->count ?
+            &old_sources->items[old_index] : 0;
+        const desirability_source *new_source = new_index < new_sources->count ?
+            &new_sources->items[new_index] : 0;
+        if (old_source && new_source && old_source->key == new_source->key) {
+            if (!is_same_source(old_source, new_source)) {
+                apply_source(old_source, -1);
+                apply_source(new_source, 1);
+            }
+            old_index++;
+            new_index++;
+        } else if (old_source && (!new_source || old_source->key < new_source->key)) {
+            apply_source(old_source, -1);
+            old_index++;
+        } else {
+            apply_source(new_source, 1);
+            new_index++;
+        }
+    }
+}
+
+static void build_buckets(const source_list *sources)
+{
+    if (incremental.buckets.capacity < sources->count) {
+        int *items = realloc(incremental.buckets.items, sizeof(int) * sources->count);
+        if (!items) {
+            return;
+        }
+        incremental.buckets.items = items;
+        incremental.buckets.capacity = sources->count;
+    }
+    int *start = incremental.buckets.start;
+    memset(start, 0, sizeof(incremental.buckets.start));
+    incremental.buckets.max_size = 1;
+    for (int i = 0; i < sources->count; i++) {
+        const desirability_source *s = &sources->items[i];
+        if (s->size > incremental.buckets.max_size) {
+            incremental.buckets.max_size = s->size;
+        }
+        start[(s->y / BUCKET_SIZE) * BUCKETS_PER_ROW + s->x / BUCKET_SIZE + 1]++;
+    }
+    for (int i = 1; i <= BUCKETS_PER_ROW * BUCKETS_PER_ROW; i++) {
+        start[i] += start[i - 1];
+    }
+    // Filled in source order, so each bucket is sorted
+    int fill[BUCKETS_PER_ROW * BUCKETS_PER_ROW];
+    memcpy(fill, start, sizeof(fill));
+    for (int i = 0; i < sources->count; i++) {
+        const desirability_source *s = &sources->items[i];
+        incremental.buckets.items[fill[(s->y / BUCKET_SIZE) * BUCKETS_PER_ROW + s->x / BUCKET_SIZE]++] = i;
+    }
+    incremental.buckets.is_valid = 1;
+}
+
+static int get_contribution(const desirability_source *s, int x, int y)
+{
+    int dx = 0;
+    if (x < s->x) {
+        dx = s->x - x;
+    } else if (x > s->x + s->size - 1) {
+        dx = x - (s->x + s->size - 1);
+    }
+    int dy = 0;
+    if (y < s->y) {
+        dy = s->y - y;
+    } else if (y > s->y + s->size - 1) {
+        dy = y - (s->y + s->size - 1);
+    }
+    int distance = dx > dy ? dx : dy;
+    int range = s->range > MAX_RANGE ? MAX_RANGE : s->range;
+    if (s->size <= 0 || distance < 1 || distance > range) {
+        return 0;
+    }
+    // The value changes by step_size every step tiles, or every tile when step is below 1
+    int step = s->step < 1 ? 1 : s->step;
+    return s->value + s->step_size * ((distance - 1) / step);
+}
+
+static int compare_int(const void *a, const void *b)
+{
+    return *(const int *) a - *(const int *) b;
+}
+
+static int replay_tile(const source_list *sources, int x, int y, int *desirability)
+{
+    int candidates[MAX_SOURCES_PER_TILE];
+    int num_candidates = 0;
+    int reach = MAX_RANGE + incremental.buckets.max_size - 1;
+    int bucket_x_min = calc_bound((x - reach) / BUCKET_SIZE, 0, BUCKETS_PER_ROW - 1);
+    int bucket_x_max = calc_bound((x + MAX_RANGE) / BUCKET_SIZE, 0, BUCKETS_PER_ROW - 1);
+    int bucket_y_min = calc_bound((y - reach) / BUCKET_SIZE, 0, BUCKETS_PER_ROW - 1);
+    int bucket_y_max = calc_bound((y + MAX_RANGE) / BUCKET_SIZE, 0, BUCKETS_PER_ROW - 1);
+    for (int bucket_y = bucket_y_min; bucket_y <= bucket_y_max; bucket_y++) {
+        for (int bucket_x = bucket_x_min; bucket_x <= bucket_x_max; bucket_x++) {
+            int bucket = bucket_y * BUCKETS_PER_ROW + bucket_x;
+            for (int i = incremental.buckets.start[bucket]; i < incremental.buckets.start[bucket + 1]; i++) {
+                int index = incremental.buckets.items[i];
+                if (!get_contribution(&sources->items[index], x, y)) {
+                    continue;
+                }
+                if (num_candidates >= MAX_SOURCES_PER_TILE) {
+                    return 0;
+                }
+                candidates[num_candidates++] = index;
+            }
+        }
+    }
+    qsort(candidates, num_candidates, sizeof(int), compare_int);
+    *desirability = 0;
+    for (int i = 0; i < num_candidates; i++) {
+        *desirability = calc_bound(*desirability + get_contribution(&sources->items[candidates[i]], x, y),
+            MIN_DESIRABILITY, MAX_DESIRABILITY);
+    }
+    return 1;
+}
+
+static int resolve_changed_tile(const source_list *sources, const changed_tile *tile)
+{
+    int grid_offset = tile->grid_offset;
+    if (incremental.positive[grid_offset] <= MAX_DESIRABILITY &&
+        incremental.negative[grid_offset] >= MIN_DESIRABILITY) {
+        desirability_grid.items[grid_offset] = incremental.sum[grid_offset];
+        return 1;
+    }
+    if (!incremental.buckets.is_valid) {
+        build_buckets(sources);
+    }
+    int desirability;
+    // Out of memory or too many sources on the tile to replay
+    if (!incremental.buckets.is_valid || !replay_tile(sources, tile->x, tile->y, &desirability)) {
+        return 0;
+    }
+    desirability_grid.items[grid_offset] = desirability;
+    return 1;
+}
+
+static void resolve_changed_tiles(const source_list *sources)
+{
+    incremental.buckets.is_valid = 0;
+    for (int i = 0; i < incremental.num_changed; i++) {
+        if (!resolve_changed_tile(sources, &incremental.changed[i])) {
+            // Fall back to the full rebuild
+            incremental.is_valid = 0;
+            break;
+        }
+    }
+    for (int i = 0; i < incremental.num_changed; i++) {
+        incremental.is_changed.items[incremental.changed[i].grid_offset] = 0;
+    }
+    incremental.num_changed = 0;
+}
+
+static void start_incremental(const source_list *sources)
+{
+    memset(incremental.sum, 0, sizeof(incremental.sum));
+    memset(incremental.positive, 0, sizeof(incremental.positive));
+    memset(incremental.negative, 0, sizeof(incremental.negative));
+    for (int i = 0; i < sources->count; i++) {
+        apply_source(&sources->items[i], 1);
+    }
+    // The sums already match the full rebuild, which also sets untouched tiles to zero
+    for (int i = 0; i < incremental.num_changed; i++) {
+        incremental.is_changed.items[incremental.changed[i].grid_offset] = 0;
+    }
+    incremental.num_changed = 0;
+    incremental.is_valid = 1;
+}
+
+#if VERIFY_INCREMENTAL_UPDATES
+static void verify_incremental_update(const source_list *sources)
+{
+    static grid_i8 incremental_grid;
+    memcpy(&incremental_grid, &desirability_grid, sizeof(grid_i8));
+    rebuild_full(sources);
+    int mismatches = 0;
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        if (incremental_grid.items[i] != desirability_grid.items[i]) {
+            mismatches++;
+        }
+    }
+    if (mismatches) {
+        log_error("Incremental desirability differs from full rebuild, tiles:", 0, mismatches);
+    }
+}
+#endif
+
+void map_desirability_update(void)
+{
+    const source_list *old_sources = &incremental.lists[incremental.current];
+    collect_sources();
+    const source_list *new_sources = &incremental.lists[incremental.current];
+
+    if (!incremental.is_valid) {
+        rebuild_full(new_sources);
+        start_incremental(new_sources);
+        return;
+    }
+    apply_changed_sources(old_sources, new_sources);
+    resolve_changed_tiles(new_sources);
+    if (!incremental.is_valid) {
+        rebuild_full(new_sources);
+        return;
+    }
+#if VERIFY_INCREMENTAL_UPDATES
+    verify_incremental_update(new_sources);
+#endif
+}
+
 int map_desirability_get(int grid_offset)
 {
     return desirability_grid.items[grid_offset];
@@ -229,4 +601,5 @@ void map_desirability_save_state(buffer *buf)
 void map_desirability_load_state(buffer *buf)
 {
     map_grid_load_state_i8(desirability_grid.items, buf);
+    incremental.is_valid = 0;
 }
@@ -1,9 +1,23 @@
 #include "figure.h"
 
+#include "core/calc.h"
 #include "map/grid.h"
 
+#define BUCKET_SIZE 8
+#define BUCKETS_PER_ROW ((GRID_SIZE + BUCKET_SIZE - 1) / BUCKET_SIZE)
+
 static grid_u16 figures;
 
+static struct {
+    uint16_t counts[BUCKETS_PER_ROW * BUCKETS_PER_ROW];
+    int is_valid;
+} buckets;
+
+static int bucket_index(int grid_offset)
+{
+    return (grid_offset / GRID_SIZE / BUCKET_SIZE) * BUCKETS_PER_ROW + (grid_offset % GRID_SIZE) / BUCKET_SIZE;
+}
+
 int map_has_figure_at(int grid_offset)
 {
     return map_grid_is_valid_offset(grid_offset) && figures.items[grid_offset] > 0;
@@ -41,6 +55,7 @@ void map_figure_add(figure *f)
     } else {
         figures.items[f->grid_offset] = f->id;
     }
+    buckets.counts[bucket_index(f->grid_offset)]++;
 }
 
 void map_figure_update(figure *f)
@@ -70,12 +85,16 @@ void map_figure_delete(figure *f)
     }
     if (figures.items[f->grid_offset] == f->id) {
         figures.items[f->grid_offset] = f->next_figure_id_on_same_tile;
+        buckets.counts[bucket_index(f->grid_offset)]--;
     } else {
         figure *prev = figure_get(figures.items[f->grid_offset]);
         while (prev->id && prev->next_figure_id_on_same_tile != f->id) {
             prev = figure_get(prev->next_figure_id_on_same_tile);
         }
         prev->next_figure_id_on_same_tile = f->next_figure_id_on_same_tile;
+        if (prev->id) {
+            buckets.counts[bucket_index(f->grid_offset)]--;
+        }
     }
     f->next_figure_id_on_same_tile = 0;
 }
@@ -96,9 +115,59 @@ int map_figure_foreach_until(int grid_offset, int (*callback)(figure *f))
     return 0;
 }
 
+static int count_figure(figure *f)
+{
+    buckets.counts[bucket_index(f->grid_offset)]++;
+    return 0;
+}
+
+static void update_bucket_counts(void)
+{
+    for (int i = 0; i < BUCKETS_PER_ROW * BUCKETS_PER_ROW; i++) {
+        buckets.counts[i] = 0;
+    }
+    for (int grid_offset = 0; grid_offset < GRID_SIZE * GRID_SIZE; grid_offset++) {
+        map_figure_foreach_until(grid_offset, count_figure);
+    }
+    buckets.is_valid = 1;
+}
+
+void map_figure_foreach_in_area(int x_min, int y_min, int x_max, int y_max, void (*callback)(figure *f))
+{
+    if (!buckets.is_valid) {
+        update_bucket_counts();
+    }
+    // figures on the map border are included, so the area is bound to the grid instead of the map
+    int start_offset = map_grid_offset(0, 0);
+    int gx_min = calc_bound(start_offset % GRID_SIZE + x_min, 0, GRID_SIZE - 1);
+    int gy_min = calc_bound(start_offset / GRID_SIZE + y_min, 0, GRID_SIZE - 1);
+    int gx_max = calc_bound(start_offset % GRID_SIZE + x_max, 0, GRID_SIZE - 1);
+    int gy_max = calc_bound(start_offset / GRID_SIZE + y_max, 0, GRID_SIZE - 1);
+    for (int by = gy_min / BUCKET_SIZE; by <= gy_max / BUCKET_SIZE; by++) {
+        for (int bx = gx_min / BUCKET_SIZE; bx <= gx_max / BUCKET_SIZE; bx++) {
+            if (!buckets.counts[by * BUCKETS_PER_ROW + bx]) {
+                continue;
+            }
+            int y_end = calc_bound(by * BUCKET_SIZE + BUCKET_SIZE - 1, gy_min, gy_max);
+            int x_end = calc_bound(bx * BUCKET_SIZE + BUCKET_SIZE - 1, gx_min, gx_max);
+            for (int gy = calc_bound(by * BUCKET_SIZE, gy_min, gy_max); gy <= y_end; gy++) {
+                for (int gx = calc_bound(bx * BUCKET_SIZE, gx_min, gx_max); gx <= x_end; gx++) {
+                    int figure_id = figures.items[gy * GRID_SIZE + gx];
+                    while (figure_id) {
+                        figure *f = figure_get(figure_id);
+                        figure_id = f->next_figure_id_on_same_tile;
+                        callback(f);
+                    }
+                }
+            }
+        }
+    }
+}
+
 void map_figure_clear(void)
 {
     map_grid_clear_u16(figures.items);
+    buckets.is_valid = 0;
 }
 
 void map_figure_save_state(buffer *buf)
@@ -109,4 +178,6 @@ void map_figure_save_state(buffer *buf)
 void map_figure_load_state(buffer *buf)
 {
     map_grid_load_state_u16(figures.items, buf);
+    // figures may not be loaded yet, counts are rebuilt on first use
+    buckets.is_valid = 0;
 }
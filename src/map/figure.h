@@ -26,6 +26,17 @@ void map_figure_delete(figure *f);
 
 int map_figure_foreach_until(int grid_offset, int (*callback)(figure *f));
 
+/**
+ * Calls the callback for every figure on the map tiles in the given area.
+ * Tiles are skipped in blocks when no figure is present on them.
+ * @param x_min Minimum X of the area
+ * @param y_min Minimum Y of the area
+ * @param x_max Maximum X of the area
+ * @param y_max Maximum Y of the area
+ * @param callback Function to call for each figure
+ */
+void map_figure_foreach_in_area(int x_min, int y_min, int x_max, int y_max, void (*callback)(figure *f));
+
 /**
  * Clears the map
  */
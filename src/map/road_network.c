@@ -6,13 +6,12 @@
 #include "map/routing_terrain.h"
 #include "map/terrain.h"
 
-#include <string.h>
-
 #define MAX_QUEUE 1000
 
 static const int ADJACENT_OFFSETS[] = {-GRID_SIZE, 1, GRID_SIZE, -1};
 
 static grid_u8 network;
+static int network_is_outdated = 1;
 
 static struct {
     int items[MAX_QUEUE];
@@ -23,6 +22,12 @@ static struct {
 void map_road_network_clear(void)
 {
     map_grid_clear_u8(network.items);
+    network_is_outdated = 1;
+}
+
+void map_road_network_invalidate(void)
+{
+    network_is_outdated = 1;
 }
 
 int map_road_network_get(int grid_offset)
@@ -32,7 +37,8 @@ int map_road_network_get(int grid_offset)
 
 static int mark_road_network(int grid_offset, uint8_t network_id)
 {
-    memset(&queue, 0, sizeof(queue));
+    queue.head = 0;
+    queue.tail = 0;
     int guard = 0;
     int next_offset;
     int size = 1;
@@ -79,6 +85,12 @@ static int mark_road_network(int grid_offset, uint8_t network_id)
 
 void map_road_network_update(void)
 {
+    // Network ids are numbered in map order and saved with the buildings, so the networks are always
+    // relabelled as a whole, but only when the roads or the citizen routing grid have changed
+    if (!network_is_outdated) {
+        return;
+    }
+    network_is_outdated = 0;
     city_map_clear_largest_road_networks();
     map_grid_clear_u8(network.items);
     int network_id = 1;
@@ -5,6 +5,8 @@ void map_road_network_clear(void);
 
 int map_road_network_get(int grid_offset);
 
+void map_road_network_invalidate(void);
+
 void map_road_network_update(void);
 
 #endif // MAP_ROAD_NETWORK_H
@@ -7,6 +7,7 @@
 #include "map/grid.h"
 #include "map/road_aqueduct.h"
 #include "map/routing_data.h"
+#include "map/routing_regions.h"
 #include "map/terrain.h"
 #include "map/tiles.h"
 
@@ -48,6 +49,7 @@ static struct {
     int head;
     int tail;
     int items[MAX_QUEUE];
+    int heap_index[MAX_QUEUE]; // grid offset -> slot in items, only valid while the offset is in the ordered queue
 } queue;
 
 static grid_u8 water_drag;
@@ -108,11 +110,17 @@ static inline int ordered_queue_parent(int index)
     return (index - 1) / 2;
 }
 
+static inline void ordered_queue_set(int index, int offset)
+{
+    queue.items[index] = offset;
+    queue.heap_index[offset] = index;
+}
+
 static inline void ordered_queue_swap(int first, int second)
 {
     int temp = queue.items[first];
-    queue.items[first] = queue.items[second];
-    queue.items[second] = temp;
+    ordered_queue_set(first, queue.items[second]);
+    ordered_queue_set(second, temp);
 }
 
 static void ordered_queue_reorder(int start_index)
@@ -141,14 +149,14 @@ static void ordered_queue_reorder(int start_index)
 static inline int ordered_queue_pop(void)
 {
     int min = queue.items[0];
-    queue.items[0] = queue.items[--queue.tail];
+    ordered_queue_set(0, queue.items[--queue.tail]);
     ordered_queue_reorder(0);
     return min;
 }
 
 static inline void ordered_queue_reduce_index(int index, int offset, int dist)
 {
-    queue.items[index] = offset;
+    ordered_queue_set(index, offset);
     while (index && distance.possible.items[queue.items[ordered_queue_parent(index)]] > dist) {
         ordered_queue_swap(index, ordered_queue_parent(index));
         index = ordered_queue_parent(index);
@@ -162,14 +170,9 @@ static void ordered_enqueue(int next_offset, int current_dist, int remaining_dis
     if (distance.possible.items[next_offset]) {
         if (distance.possible.items[next_offset] <= possible_dist) {
             return;
-        } else {
-            for (int i = 0; i < queue.tail; i++) {
-                if (queue.items[i] == next_offset) {
-                    index = i;
-                    break;
-                }
-            }
         }
+        // Already queued with a worse distance: move it up from its current slot
+        index = queue.heap_index[next_offset];
     } else {
         queue.tail++;
     }
@@ -550,14 +553,22 @@ static int callback_travel_citizen_road_garden(int offset, int next_offset, int
     return 0;
 }
 
+static int is_road_garden_destination(int dst_offset)
+{
+    return terrain_land_citizen.items[dst_offset] == CITIZEN_0_ROAD ||
+        terrain_land_citizen.items[dst_offset] == CITIZEN_2_PASSABLE_TERRAIN;
+}
+
 int map_routing_citizen_can_travel_over_road_garden(int src_x, int src_y, int dst_x, int dst_y, int num_directions)
 {
     int dst_offset = map_grid_offset(dst_x, dst_y);
-    if (terrain_land_citizen.items[dst_offset] != CITIZEN_0_ROAD &&
-        terrain_land_citizen.items[dst_offset] != CITIZEN_2_PASSABLE_TERRAIN) {
+    if (!is_road_garden_destination(dst_offset)) {
         return 0;
     }
     ++stats.total_routes_calculated;
+    if (!map_routing_regions_may_connect(ROUTING_REGIONS_ROAD_GARDEN, map_grid_offset(src_x, src_y), dst_offset)) {
+        return 0;
+    }
     route_queue_from_to(src_x, src_y, dst_x, dst_y, num_directions, 0, callback_travel_citizen_road_garden);
     return distance.determined.items[dst_offset] != 0;
 }
@@ -571,14 +582,23 @@ static int callback_travel_citizen_road_garden_highway(int offset, int next_offs
     return 0;
 }
 
+static int is_road_garden_highway_destination(int dst_offset)
+{
+    return terrain_land_citizen.items[dst_offset] >= CITIZEN_0_ROAD &&
+        terrain_land_citizen.items[dst_offset] <= CITIZEN_2_PASSABLE_TERRAIN;
+}
+
 int map_routing_citizen_can_travel_over_road_garden_highway(int src_x, int src_y, int dst_x, int dst_y, int num_directions)
 {
     int dst_offset = map_grid_offset(dst_x, dst_y);
-    if (terrain_land_citizen.items[dst_offset] < CITIZEN_0_ROAD ||
-        terrain_land_citizen.items[dst_offset] > CITIZEN_2_PASSABLE_TERRAIN) {
+    if (!is_road_garden_highway_destination(dst_offset)) {
         return 0;
     }
     ++stats.total_routes_calculated;
+    if (!map_routing_regions_may_connect(ROUTING_REGIONS_ROAD_GARDEN_HIGHWAY,
+            map_grid_offset(src_x, src_y), dst_offset)) {
+        return 0;
+    }
     route_queue_from_to(src_x, src_y, dst_x, dst_y, num_directions, 0, callback_travel_citizen_road_garden_highway);
     return distance.determined.items[dst_offset] != 0;
 }
@@ -676,6 +696,36 @@ int map_routing_distance(int grid_offset)
     return distance.determined.items[grid_offset];
 }
 
+void map_routing_count_skipped_citizen_route_over_road_garden(int dst_x, int dst_y)
+{
+    if (is_road_garden_destination(map_grid_offset(dst_x, dst_y))) {
+        ++stats.total_routes_calculated;
+    }
+}
+
+void map_routing_count_skipped_citizen_route_over_road_garden_highway(int dst_x, int dst_y)
+{
+    if (is_road_garden_highway_destination(map_grid_offset(dst_x, dst_y))) {
+        ++stats.total_routes_calculated;
+    }
+}
+
+void map_routing_count_skipped_route_over_walls(void)
+{
+    ++stats.total_routes_calculated;
+}
+
+void map_routing_count_skipped_noncitizen_route_over_land(void)
+{
+    ++stats.total_routes_calculated;
+    ++stats.enemy_routes_calculated;
+}
+
+void map_routing_count_skipped_noncitizen_route_through_everything(void)
+{
+    ++stats.total_routes_calculated;
+}
+
 void map_routing_save_state(buffer *buf)
 {
     buffer_write_i32(buf, 0); // unused counter
@@ -40,6 +40,38 @@ int map_routing_noncitizen_can_travel_over_land(
     int src_x, int src_y, int dst_x, int dst_y, int num_directions, int only_through_building_id, int max_tiles);
 int map_routing_noncitizen_can_travel_through_everything(int src_x, int src_y, int dst_x, int dst_y, int num_directions);
 
+/**
+ * Counts a road route whose result was taken from the routing cache instead of searching for it.
+ * Destinations that aren't road or garden aren't counted, like in map_routing_citizen_can_travel_over_road_garden().
+ * @param dst_x Destination x
+ * @param dst_y Destination y
+ */
+void map_routing_count_skipped_citizen_route_over_road_garden(int dst_x, int dst_y);
+
+/**
+ * Counts a road or highway route whose result was taken from the routing cache instead of searching for it.
+ * @param dst_x Destination x
+ * @param dst_y Destination y
+ */
+void map_routing_count_skipped_citizen_route_over_road_garden_highway(int dst_x, int dst_y);
+
+/**
+ * Counts a wall route whose result was taken from the routing cache instead of searching for it.
+ */
+void map_routing_count_skipped_route_over_walls(void);
+
+/**
+ * Counts a non-citizen land route that was not searched because it cannot reach its destination.
+ * The route counters are saved, so they must not depend on which searches were skipped.
+ */
+void map_routing_count_skipped_noncitizen_route_over_land(void);
+
+/**
+ * Counts a route through everything that was not searched because it cannot reach its destination.
+ * The route counters are saved, so they must not depend on which searches were skipped.
+ */
+void map_routing_count_skipped_noncitizen_route_through_everything(void);
+
 void map_routing_block(int x, int y, int size);
 
 void map_routing_save_state(buffer *buf);
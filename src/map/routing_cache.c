@@ -0,0 +1,128 @@
+#include "routing_cache.h"
+
+#include "core/log.h"
+
+#include <string.h>
+
+#define MAX_PATH 500
+#define CACHE_SETS 64
+#define CACHE_WAYS 4
+
+typedef struct {
+    int in_use;
+    unsigned int generation;
+    unsigned int last_used;
+    routing_cache_route route;
+    int src_offset;
+    int dst_offset;
+    int num_directions;
+    int can_travel;
+    int path_length;
+    uint64_t micros;
+    uint8_t path[MAX_PATH];
+} cache_entry;
+
+static struct {
+    cache_entry entries[CACHE_SETS][CACHE_WAYS];
+    unsigned int land_generation;
+    unsigned int walls_generation;
+    unsigned int use_counter;
+    routing_cache_stats stats;
+} data;
+
+static unsigned int current_generation(routing_cache_route route)
+{
+    return route == ROUTING_CACHE_WALLS ? data.walls_generation : data.land_generation;
+}
+
+static cache_entry *get_set(int src_offset, int dst_offset)
+{
+    unsigned int hash = (unsigned int) src_offset * 31u + (unsigned int) dst_offset * 17u;
+    return data.entries[(hash ^ (hash >> 6)) % CACHE_SETS];
+}
+
+static int entry_matches(const cache_entry *entry, routing_cache_route route,
+    int src_offset, int dst_offset, int num_directions)
+{
+    return entry->in_use && entry->generation == current_generation(route) && entry->route == route &&
+        entry->src_offset == src_offset && entry->dst_offset == dst_offset &&
+        entry->num_directions == num_directions;
+}
+
+int map_routing_cache_get(routing_cache_route route, int src_offset, int dst_offset, int num_directions,
+    uint8_t *path, int *path_length, int *can_travel)
+{
+    data.stats.lookups++;
+    cache_entry *set = get_set(src_offset, dst_offset);
+    for (int i = 0; i < CACHE_WAYS; i++) {
+        cache_entry *entry = &set[i];
+        if (entry_matches(entry, route, src_offset, dst_offset, num_directions)) {
+            entry->last_used = ++data.use_counter;
+            memcpy(path, entry->path, entry->path_length);
+            *path_length = entry->path_length;
+            *can_travel = entry->can_travel;
+            data.stats.hits++;
+            data.stats.micros_saved += entry->micros;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void map_routing_cache_store(routing_cache_route route, int src_offset, int dst_offset, int num_directions,
+    const uint8_t *path, int path_length, int can_travel, uint64_t micros)
+{
+    data.stats.micros_computing += micros;
+    if (path_length < 0 || path_length > MAX_PATH) {
+        return;
+    }
+    cache_entry *set = get_set(src_offset, dst_offset);
+    cache_entry *entry = &set[0];
+    for (int i = 0; i < CACHE_WAYS; i++) {
+        if (!set[i].in_use || set[i].generation != current_generation(set[i].route)) {
+            entry = &set[i];
+            break;
+        }
+        if (set[i].last_used < entry->last_used) {
+            entry = &set[i];
+        }
+    }
+    entry->in_use = 1;
+    entry->generation = current_generation(route);
+    entry->last_used = ++data.use_counter;
+    entry->route = route;
+    entry->src_offset = src_offset;
+    entry->dst_offset = dst_offset;
+    entry->num_directions = num_directions;
+    entry->can_travel = can_travel;
+    entry->path_length = path_length;
+    entry->micros = micros;
+    memcpy(entry->path, path, path_length);
+}
+
+void map_routing_cache_invalidate_land(void)
+{
+    data.land_generation++;
+    data.stats.invalidations++;
+}
+
+void map_routing_cache_invalidate_walls(void)
+{
+    data.walls_generation++;
+    data.stats.invalidations++;
+}
+
+void map_routing_cache_clear(void)
+{
+    if (data.stats.lookups) {
+        log_info("Routing cache lookups:", 0, data.stats.lookups);
+        log_info("Routing cache hits:", 0, data.stats.hits);
+        log_info("Routing cache time saved (ms):", 0, (int) (data.stats.micros_saved / 1000));
+    }
+    memset(&data, 0, sizeof(data));
+}
+
+const routing_cache_stats *map_routing_cache_get_stats(void)
+{
+    return &data.stats;
+}
@@ -0,0 +1,64 @@
+#ifndef MAP_ROUTING_CACHE_H
+#define MAP_ROUTING_CACHE_H
+
+#include <stdint.h>
+
+/**
+ * @file
+ * Cache of computed land paths whose result only depends on the routing terrain.
+ * Entries are dropped as a whole whenever the relevant routing terrain changes.
+ */
+
+typedef enum {
+    ROUTING_CACHE_ROAD_GARDEN,
+    ROUTING_CACHE_ROAD_GARDEN_HIGHWAY,
+    ROUTING_CACHE_WALLS
+} routing_cache_route;
+
+typedef struct {
+    int lookups;
+    int hits;
+    int invalidations;
+    uint64_t micros_computing;
+    uint64_t micros_saved;
+} routing_cache_stats;
+
+/**
+ * Looks up a previously computed path
+ * @param route Kind of route
+ * @param src_offset Source grid offset
+ * @param dst_offset Destination grid offset
+ * @param num_directions Number of directions the route was allowed to use
+ * @param path Buffer to receive the directions, must hold at least 500 entries
+ * @param path_length Receives the path length
+ * @param can_travel Receives whether the destination was reachable
+ * @return 1 if the path was found in the cache, 0 otherwise
+ */
+int map_routing_cache_get(routing_cache_route route, int src_offset, int dst_offset, int num_directions,
+    uint8_t *path, int *path_length, int *can_travel);
+
+/**
+ * Stores a computed path
+ * @param micros Time it took to compute the path, used for statistics
+ */
+void map_routing_cache_store(routing_cache_route route, int src_offset, int dst_offset, int num_directions,
+    const uint8_t *path, int path_length, int can_travel, uint64_t micros);
+
+/**
+ * Drops all cached paths that use the land citizen routing terrain
+ */
+void map_routing_cache_invalidate_land(void);
+
+/**
+ * Drops all cached paths that use the walls routing terrain
+ */
+void map_routing_cache_invalidate_walls(void);
+
+/**
+ * Drops all cached paths and resets the statistics
+ */
+void map_routing_cache_clear(void);
+
+const routing_cache_stats *map_routing_cache_get_stats(void);
+
+#endif // MAP_ROUTING_CACHE_H
@@ -0,0 +1,503 @@
+#include "routing_regions.h"
+
+#include "building/building.h"
+#include "map/building.h"
+#include "map/data.h"
+#include "map/grid.h"
+#include "map/routing_data.h"
+
+#define MAX_QUEUE (GRID_SIZE * GRID_SIZE)
+#define MAX_BUILDING_TILES 64
+#define MAX_LINKED_REGIONS 64
+#define MAX_WALKABLE_BUILDINGS 2
+#define MAX_CHANGED_TILES 1000
+#define MAX_REGION_ID 0xffff
+
+// Diagonal routes may cut corners, so regions are 8-connected to cover both direction limits
+static const int ADJACENT_OFFSETS[] = {
+    -GRID_SIZE, 1, GRID_SIZE, -1, -GRID_SIZE + 1, GRID_SIZE + 1, GRID_SIZE - 1, -GRID_SIZE - 1
+};
+
+// The same neighbours in clockwise order, starting north
+static const int RING_OFFSETS[] = {
+    -GRID_SIZE, -GRID_SIZE + 1, 1, GRID_SIZE + 1, GRID_SIZE, GRID_SIZE - 1, -1, -GRID_SIZE - 1
+};
+
+typedef struct {
+    int size;
+    uint16_t ids[MAX_LINKED_REGIONS];
+} region_set;
+
+typedef struct {
+    int num_tiles;
+    int tiles[MAX_BUILDING_TILES];
+    region_set adjacent_regions;
+} walkable_building;
+
+static struct {
+    grid_u16 region[ROUTING_REGIONS_MAX];
+    int is_valid[ROUTING_REGIONS_MAX];
+    uint16_t next_region_id[ROUTING_REGIONS_MAX];
+    int queue[MAX_QUEUE];
+    int changed_tiles[MAX_CHANGED_TILES];
+    int num_changed_tiles;
+} data;
+
+static int is_passable_citizen_terrain(routing_regions_type type, int8_t terrain)
+{
+    if (type == ROUTING_REGIONS_ROAD_GARDEN) {
+        return terrain == CITIZEN_0_ROAD || terrain == CITIZEN_2_PASSABLE_TERRAIN;
+    } else {
+        return terrain >= CITIZEN_0_ROAD && terrain <= CITIZEN_2_PASSABLE_TERRAIN;
+    }
+}
+
+static int is_passable(routing_regions_type type, int grid_offset)
+{
+    int8_t terrain;
+    switch (type) {
+        case ROUTING_REGIONS_ROAD_GARDEN:
+        case ROUTING_REGIONS_ROAD_GARDEN_HIGHWAY:
+            return is_passable_citizen_terrain(type, terrain_land_citizen.items[grid_offset]);
+        case ROUTING_REGIONS_NONCITIZEN_OPEN:
+            terrain = terrain_land_noncitizen.items[grid_offset];
+            return terrain == NONCITIZEN_0_PASSABLE || terrain == NONCITIZEN_2_CLEARABLE;
+        case ROUTING_REGIONS_NONCITIZEN_LAND:
+            terrain = terrain_land_noncitizen.items[grid_offset];
+            return terrain >= NONCITIZEN_0_PASSABLE && terrain < NONCITIZEN_5_FORT;
+        case ROUTING_REGIONS_NONCITIZEN_ANY:
+            return terrain_land_noncitizen.items[grid_offset] >= NONCITIZEN_0_PASSABLE;
+        default:
+            return 0;
+    }
+}
+
+static void mark_region(routing_regions_type type, int grid_offset, uint16_t region_id)
+{
+    uint16_t *region = data.region[type].items;
+    int head = 0;
+    int tail = 0;
+    region[grid_offset] = region_id;
+    data.queue[tail++] = grid_offset;
+    while (head < tail) {
+        int offset = data.queue[head++];
+        for (int i = 0; i < 8; i++) {
+            int next_offset = offset + ADJACENT_OFFSETS[i];
+            if (map_grid_is_valid_offset(next_offset) && !region[next_offset] && is_passable(type, next_offset)) {
+                region[next_offset] = region_id;
+                data.queue[tail++] = next_offset;
+            }
+        }
+    }
+}
+
+static void update_regions(routing_regions_type type)
+{
+    uint16_t *region = data.region[type].items;
+    map_grid_clear_u16(region);
+    uint16_t region_id = 1;
+    int grid_offset = map_data.start_offset;
+    for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
+        for (int x = 0; x < map_data.width; x++, grid_offset++) {
+            if (!region[grid_offset] && is_passable(type, grid_offset)) {
+                mark_region(type, grid_offset, region_id++);
+            }
+        }
+    }
+    data.next_region_id[type] = region_id;
+    data.is_valid[type] = 1;
+}
+
+static int is_labelled(const uint16_t *region, int grid_offset)
+{
+    return map_grid_is_valid_offset(grid_offset) && region[grid_offset];
+}
+
+static int find_ring_root(int *parent, int index)
+{
+    while (parent[index] != index) {
+        index = parent[index];
+    }
+    return index;
+}
+
+static void join_ring_tiles(int *parent, int index, int other_index)
+{
+    parent[find_ring_root(parent, index)] = find_ring_root(parent, other_index);
+}
+
+static int count_ring_components(const uint16_t *region, int grid_offset)
+{
+    // Neighbours that follow each other around the tile are adjacent,
+    // and so are two straight neighbours with a diagonal one between them
+    int labelled[8];
+    int parent[8];
+    for (int i = 0; i < 8; i++) {
+        labelled[i] = is_labelled(region, grid_offset + RING_OFFSETS[i]);
+        parent[i] = i;
+    }
+    for (int i = 0; i < 8; i++) {
+        int next = (i + 1) % 8;
+        if (labelled[i] && labelled[next]) {
+            join_ring_tiles(parent, i, next);
+        }
+        int next_straight = (i + 2) % 8;
+        if (i % 2 == 0 && labelled[i] && labelled[next_straight]) {
+            join_ring_tiles(parent, i, next_straight);
+        }
+    }
+    int components = 0;
+    for (int i = 0; i < 8; i++) {
+        if (labelled[i] && find_ring_root(parent, i) == i) {
+            components++;
+        }
+    }
+    return components;
+}
+
+static int remove_tile(routing_regions_type type, int grid_offset)
+{
+    // If the neighbours stay connected around the tile, every route through it can go around it instead.
+    // Otherwise the region may have been split and has to be labelled again.
+    uint16_t *region = data.region[type].items;
+    if (count_ring_components(region, grid_offset) > 1) {
+        return 0;
+    }
+    region[grid_offset] = 0;
+    return 1;
+}
+
+static int add_tile(routing_regions_type type, int grid_offset)
+{
+    uint16_t *region = data.region[type].items;
+    uint16_t region_id = 0;
+    int needs_merge = 0;
+    for (int i = 0; i < 8; i++) {
+        int next_offset = grid_offset + ADJACENT_OFFSETS[i];
+        if (!is_labelled(region, next_offset)) {
+            continue;
+        }
+        if (!region_id) {
+            region_id = region[next_offset];
+        } else if (region[next_offset] != region_id) {
+            needs_merge = 1;
+        }
+    }
+    if (!region_id) {
+        if (data.next_region_id[type] >= MAX_REGION_ID) {
+            return 0;
+        }
+        region[grid_offset] = data.next_region_id[type]++;
+        return 1;
+    }
+    region[grid_offset] = region_id;
+    if (!needs_merge) {
+        return 1;
+    }
+    // The regions next to the tile are joined into one. Regions are never adjacent to each other,
+    // so following the tiles that have a different label only reaches the regions that touch the tile.
+    int head = 0;
+    int tail = 0;
+    data.queue[tail++] = grid_offset;
+    while (head < tail) {
+        int offset = data.queue[head++];
+        for (int i = 0; i < 8; i++) {
+            int next_offset = offset + ADJACENT_OFFSETS[i];
+            if (is_labelled(region, next_offset) && region[next_offset] != region_id) {
+                region[next_offset] = region_id;
+                data.queue[tail++] = next_offset;
+            }
+        }
+    }
+    return 1;
+}
+
+static int update_changed_tiles(routing_regions_type type, const int8_t *previous_terrain)
+{
+    // Removed tiles go first and one at a time, so each one is checked against the tiles that are still there.
+    // Added tiles are then joined to what is left.
+    for (int i = 0; i < data.num_changed_tiles; i++) {
+        int grid_offset = data.changed_tiles[i];
+        if (is_passable_citizen_terrain(type, previous_terrain[grid_offset]) && !is_passable(type, grid_offset) &&
+            !remove_tile(type, grid_offset)) {
+            return 0;
+        }
+    }
+    for (int i = 0; i < data.num_changed_tiles; i++) {
+        int grid_offset = data.changed_tiles[i];
+        if (!is_passable_citizen_terrain(type, previous_terrain[grid_offset]) && is_passable(type, grid_offset) &&
+            !add_tile(type, grid_offset)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int find_changed_tiles(const int8_t *previous_terrain)
+{
+    data.num_changed_tiles = 0;
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        if (previous_terrain[i] == terrain_land_citizen.items[i]) {
+            continue;
+        }
+        if (data.num_changed_tiles >= MAX_CHANGED_TILES) {
+            return 0;
+        }
+        data.changed_tiles[data.num_changed_tiles++] = i;
+    }
+    return 1;
+}
+
+void map_routing_regions_update_citizen(const int8_t *previous_terrain)
+{
+    if (!find_changed_tiles(previous_terrain)) {
+        // Many tiles changed, like when a game is loaded, labelling everything again is quicker
+        map_routing_regions_invalidate_citizen();
+        return;
+    }
+    for (routing_regions_type type = ROUTING_REGIONS_ROAD_GARDEN; type <= ROUTING_REGIONS_ROAD_GARDEN_HIGHWAY; type++) {
+        if (data.is_valid[type] && !update_changed_tiles(type, previous_terrain)) {
+            data.is_valid[type] = 0;
+        }
+    }
+}
+
+void map_routing_regions_invalidate_citizen(void)
+{
+    data.is_valid[ROUTING_REGIONS_ROAD_GARDEN] = 0;
+    data.is_valid[ROUTING_REGIONS_ROAD_GARDEN_HIGHWAY] = 0;
+}
+
+void map_routing_regions_invalidate_noncitizen(void)
+{
+    data.is_valid[ROUTING_REGIONS_NONCITIZEN_OPEN] = 0;
+    data.is_valid[ROUTING_REGIONS_NONCITIZEN_LAND] = 0;
+    data.is_valid[ROUTING_REGIONS_NONCITIZEN_ANY] = 0;
+}
+
+int map_routing_regions_may_connect(routing_regions_type type, int src_offset, int dst_offset)
+{
+    if (!data.is_valid[type]) {
+        update_regions(type);
+    }
+    const uint16_t *region = data.region[type].items;
+    int dst_region = region[dst_offset];
+    if (!dst_region || region[src_offset] == dst_region) {
+        return 1;
+    }
+    // The source tile itself is never checked for passability, so the route can start from any neighbour
+    for (int i = 0; i < 8; i++) {
+        int next_offset = src_offset + ADJACENT_OFFSETS[i];
+        if (map_grid_is_valid_offset(next_offset) && region[next_offset] == dst_region) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int region_set_contains(const region_set *set, uint16_t region_id)
+{
+    for (int i = 0; i < set->size; i++) {
+        if (set->ids[i] == region_id) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int region_set_add(region_set *set, uint16_t region_id)
+{
+    if (!region_id || region_set_contains(set, region_id)) {
+        return 1;
+    }
+    if (set->size >= MAX_LINKED_REGIONS) {
+        return 0;
+    }
+    set->ids[set->size++] = region_id;
+    return 1;
+}
+
+static int region_set_add_all(region_set *set, const region_set *other)
+{
+    for (int i = 0; i < other->size; i++) {
+        if (!region_set_add(set, other->ids[i])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int region_sets_overlap(const region_set *set, const region_set *other)
+{
+    for (int i = 0; i < other->size; i++) {
+        if (region_set_contains(set, other->ids[i])) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int building_has_tile(const walkable_building *b, int grid_offset)
+{
+    for (int i = 0; i < b->num_tiles; i++) {
+        if (b->tiles[i] == grid_offset) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int building_is_next_to(const walkable_building *b, int grid_offset)
+{
+    if (building_has_tile(b, grid_offset)) {
+        return 1;
+    }
+    for (int i = 0; i < 8; i++) {
+        int next_offset = grid_offset + ADJACENT_OFFSETS[i];
+        if (map_grid_is_valid_offset(next_offset) && building_has_tile(b, next_offset)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int buildings_touch(const walkable_building *b, const walkable_building *other)
+{
+    for (int i = 0; i < b->num_tiles; i++) {
+        if (building_is_next_to(other, b->tiles[i])) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Collects the building tiles that the through-building route can walk on, and the open regions next to them.
+ * Returns 0 if the building is too large to be handled, in which case nothing can be ruled out.
+ */
+static int find_walkable_building(walkable_building *b, int building_id, int start_offset)
+{
+    const uint16_t *region = data.region[ROUTING_REGIONS_NONCITIZEN_OPEN].items;
+    int building_tiles[MAX_BUILDING_TILES];
+    int num_building_tiles = 0;
+    b->num_tiles = 0;
+    b->adjacent_regions.size = 0;
+    if (building_id <= 0) {
+        return 1;
+    }
+    if (!map_grid_is_valid_offset(start_offset) || map_building_at(start_offset) != building_id) {
+        return 0;
+    }
+    building_tiles[num_building_tiles++] = start_offset;
+    for (int current = 0; current < num_building_tiles; current++) {
+        int offset = building_tiles[current];
+        for (int i = 0; i < 8; i++) {
+            int next_offset = offset + ADJACENT_OFFSETS[i];
+            if (!map_grid_is_valid_offset(next_offset) || map_building_at(next_offset) != building_id) {
+                continue;
+            }
+            int already_found = 0;
+            for (int j = 0; j < num_building_tiles; j++) {
+                if (building_tiles[j] == next_offset) {
+                    already_found = 1;
+                    break;
+                }
+            }
+            if (!already_found) {
+                if (num_building_tiles >= MAX_BUILDING_TILES) {
+                    return 0;
+                }
+                building_tiles[num_building_tiles++] = next_offset;
+            }
+        }
+        // Passable and clearable building tiles are already part of the open regions
+        if (terrain_land_noncitizen.items[offset] != NONCITIZEN_1_BUILDING) {
+            continue;
+        }
+        b->tiles[b->num_tiles++] = offset;
+        for (int i = 0; i < 8; i++) {
+            int next_offset = offset + ADJACENT_OFFSETS[i];
+            if (map_grid_is_valid_offset(next_offset) && !region_set_add(&b->adjacent_regions, region[next_offset])) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+int map_routing_regions_may_connect_through_buildings(int src_offset, int dst_offset,
+    int building_id, int other_building_id)
+{
+    if (src_offset == dst_offset) {
+        return 1;
+    }
+    if (!data.is_valid[ROUTING_REGIONS_NONCITIZEN_OPEN]) {
+        update_regions(ROUTING_REGIONS_NONCITIZEN_OPEN);
+    }
+    const uint16_t *region = data.region[ROUTING_REGIONS_NONCITIZEN_OPEN].items;
+
+    // Building id 0 is never walkable: tiles with building terrain and no building are cleared when updating terrain
+    int building_ids[MAX_WALKABLE_BUILDINGS] = { building_id, other_building_id != building_id ? other_building_id : 0 };
+    walkable_building buildings[MAX_WALKABLE_BUILDINGS];
+    int reached_building[MAX_WALKABLE_BUILDINGS] = { 0 };
+    int merged_building[MAX_WALKABLE_BUILDINGS] = { 0 };
+    for (int i = 0; i < MAX_WALKABLE_BUILDINGS; i++) {
+        int start_offset = dst_offset;
+        if (building_ids[i] > 0 && map_building_at(dst_offset) != building_ids[i]) {
+            start_offset = building_get(building_ids[i])->grid_offset;
+        }
+        if (!find_walkable_building(&buildings[i], building_ids[i], start_offset)) {
+            return 1;
+        }
+    }
+
+    // The destination tile itself must be walkable, otherwise the route can never end on it
+    int dst_building = -1;
+    if (!region[dst_offset]) {
+        for (int i = 0; i < MAX_WALKABLE_BUILDINGS; i++) {
+            if (building_has_tile(&buildings[i], dst_offset)) {
+                dst_building = i;
+            }
+        }
+        if (dst_building < 0) {
+            return 0;
+        }
+    }
+
+    // The source tile itself is never checked for passability, so the route can start from any neighbour
+    region_set reached = { 0 };
+    region_set_add(&reached, region[src_offset]);
+    for (int i = 0; i < 8; i++) {
+        int next_offset = src_offset + ADJACENT_OFFSETS[i];
+        if (map_grid_is_valid_offset(next_offset)) {
+            region_set_add(&reached, region[next_offset]);
+        }
+    }
+    for (int i = 0; i < MAX_WALKABLE_BUILDINGS; i++) {
+        reached_building[i] = building_is_next_to(&buildings[i], src_offset);
+    }
+
+    int changed;
+    do {
+        changed = 0;
+        for (int i = 0; i < MAX_WALKABLE_BUILDINGS; i++) {
+            if (!reached_building[i] && buildings[i].num_tiles &&
+                (region_sets_overlap(&reached, &buildings[i].adjacent_regions) ||
+                (reached_building[1 - i] && buildings_touch(&buildings[i], &buildings[1 - i])))) {
+                reached_building[i] = 1;
+            }
+            if (reached_building[i] && !merged_building[i]) {
+                if (!region_set_add_all(&reached, &buildings[i].adjacent_regions)) {
+                    return 1;
+                }
+                merged_building[i] = 1;
+                changed = 1;
+            }
+        }
+    } while (changed);
+
+    if (dst_building >= 0) {
+        return reached_building[dst_building];
+    }
+    return region_set_contains(&reached, region[dst_offset]);
+}
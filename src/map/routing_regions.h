@@ -0,0 +1,59 @@
+#ifndef MAP_ROUTING_REGIONS_H
+#define MAP_ROUTING_REGIONS_H
+
+#include <stdint.h>
+
+/**
+ * @file
+ * Connected regions of the citizen road and the non-citizen land routing terrain.
+ * Used as the top level of routing: two tiles in different regions can
+ * never be connected, so the tile-level search can be skipped entirely.
+ */
+
+typedef enum {
+    ROUTING_REGIONS_ROAD_GARDEN = 0,
+    ROUTING_REGIONS_ROAD_GARDEN_HIGHWAY = 1,
+    ROUTING_REGIONS_NONCITIZEN_OPEN = 2,
+    ROUTING_REGIONS_NONCITIZEN_LAND = 3,
+    ROUTING_REGIONS_NONCITIZEN_ANY = 4,
+    ROUTING_REGIONS_MAX = 5
+} routing_regions_type;
+
+/**
+ * Marks the citizen road regions as outdated. They are recalculated on the next query.
+ */
+void map_routing_regions_invalidate_citizen(void);
+
+/**
+ * Updates the citizen road regions for the tiles that changed in the citizen routing terrain.
+ * Regions that may have been split by a removed tile are marked as outdated instead.
+ * @param previous_terrain The citizen routing terrain before it was last updated
+ */
+void map_routing_regions_update_citizen(const int8_t *previous_terrain);
+
+/**
+ * Marks the non-citizen land regions as outdated. They are recalculated on the next query.
+ */
+void map_routing_regions_invalidate_noncitizen(void);
+
+/**
+ * Checks whether a route from the source to the destination can exist
+ * @param type Terrain the route runs over
+ * @param src_offset Source grid offset, does not need to be passable itself
+ * @param dst_offset Destination grid offset
+ * @return 1 if the destination may be reachable, 0 if it is certainly not
+ */
+int map_routing_regions_may_connect(routing_regions_type type, int src_offset, int dst_offset);
+
+/**
+ * Checks whether a non-citizen route over open land and through the given buildings can exist
+ * @param src_offset Source grid offset, does not need to be passable itself
+ * @param dst_offset Destination grid offset
+ * @param building_id Building that may be walked through, 0 for none
+ * @param other_building_id Another building that may be walked through, 0 for none
+ * @return 1 if the destination may be reachable, 0 if it is certainly not
+ */
+int map_routing_regions_may_connect_through_buildings(int src_offset, int dst_offset,
+    int building_id, int other_building_id);
+
+#endif // MAP_ROUTING_REGIONS_H
@@ -9,12 +9,20 @@
 #include "map/image.h"
 #include "map/property.h"
 #include "map/random.h"
+#include "map/road_network.h"
+#include "map/routing_cache.h"
 #include "map/routing_data.h"
+#include "map/routing_regions.h"
 #include "map/sprite.h"
 #include "map/terrain.h"
 
+#include <string.h>
+
 static void map_routing_update_land_noncitizen(void);
 
+static grid_i8 previous_terrain;
+static grid_i8 previous_noncitizen_terrain;
+
 void map_routing_update_all(void)
 {
     map_routing_update_land();
@@ -101,6 +109,7 @@ static int get_land_type_citizen_aqueduct(int grid_offset)
 
 void map_routing_update_land_citizen(void)
 {
+    memcpy(previous_terrain.items, terrain_land_citizen.items, sizeof(previous_terrain.items));
     map_grid_init_i8(terrain_land_citizen.items, -1);
     int grid_offset = map_data.start_offset;
     for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
@@ -116,6 +125,7 @@ void map_routing_update_land_citizen(void)
                 if (!map_building_at(grid_offset)) {
                     // shouldn't happen
                     terrain_land_noncitizen.items[grid_offset] = CITIZEN_4_CLEAR_TERRAIN; // BUG: should be citizen?
+                    map_routing_regions_invalidate_noncitizen();
                     map_terrain_remove(grid_offset, TERRAIN_BUILDING);
                     map_image_set(grid_offset, (map_random_get(grid_offset) & 7) + image_group(GROUP_TERRAIN_GRASS_1));
                     map_property_mark_draw_tile(grid_offset);
@@ -132,6 +142,11 @@ void map_routing_update_land_citizen(void)
             }
         }
     }
+    if (memcmp(previous_terrain.items, terrain_land_citizen.items, sizeof(previous_terrain.items)) != 0) {
+        map_routing_cache_invalidate_land();
+        map_routing_regions_update_citizen(previous_terrain.items);
+        map_road_network_invalidate();
+    }
 }
 
 static int get_land_type_noncitizen(int grid_offset)
@@ -178,6 +193,7 @@ static int get_land_type_noncitizen(int grid_offset)
 
 static void map_routing_update_land_noncitizen(void)
 {
+    memcpy(previous_noncitizen_terrain.items, terrain_land_noncitizen.items, sizeof(previous_noncitizen_terrain.items));
     map_grid_init_i8(terrain_land_noncitizen.items, -1);
     int grid_offset = map_data.start_offset;
     for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
@@ -204,6 +220,10 @@ static void map_routing_update_land_noncitizen(void)
             }
         }
     }
+    if (memcmp(previous_noncitizen_terrain.items, terrain_land_noncitizen.items,
+            sizeof(previous_noncitizen_terrain.items)) != 0) {
+        map_routing_regions_invalidate_noncitizen();
+    }
 }
 
 static int is_surrounded_by_water(int grid_offset)
@@ -280,6 +300,7 @@ static int count_adjacent_wall_tiles(int grid_offset)
 
 void map_routing_update_walls(void)
 {
+    memcpy(previous_terrain.items, terrain_walls.items, sizeof(previous_terrain.items));
     map_grid_init_i8(terrain_walls.items, -1);
     int grid_offset = map_data.start_offset;
     for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
@@ -297,6 +318,9 @@ void map_routing_update_walls(void)
             }
         }
     }
+    if (memcmp(previous_terrain.items, terrain_walls.items, sizeof(previous_terrain.items)) != 0) {
+        map_routing_cache_invalidate_walls();
+    }
 }
 
 int map_routing_is_wall_passable(int grid_offset)
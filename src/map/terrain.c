@@ -4,11 +4,22 @@
 #include "core/image.h"
 #include "map/grid.h"
 #include "map/ring.h"
+#include "map/road_network.h"
 #include "map/routing.h"
 
+// Terrain the road networks are seeded from, besides the citizen routing grid
+#define ROAD_NETWORK_TERRAIN (TERRAIN_ROAD | TERRAIN_ACCESS_RAMP)
+
 static grid_u32 terrain_grid;
 static grid_u32 terrain_grid_backup;
 
+static void check_road_network_change(int grid_offset, int changed_terrain)
+{
+    if ((terrain_grid.items[grid_offset] ^ changed_terrain) & ROAD_NETWORK_TERRAIN) {
+        map_road_network_invalidate();
+    }
+}
+
 int map_terrain_is(int grid_offset, int terrain)
 {
     return map_grid_is_valid_offset(grid_offset) && terrain_grid.items[grid_offset] & terrain;
@@ -38,16 +49,19 @@ int map_terrain_get_from_buffer_32(buffer *buf, int grid_offset)
 
 void map_terrain_set(int grid_offset, int terrain)
 {
+    check_road_network_change(grid_offset, terrain);
     terrain_grid.items[grid_offset] = terrain;
 }
 
 void map_terrain_add(int grid_offset, int terrain)
 {
+    check_road_network_change(grid_offset, terrain_grid.items[grid_offset] | terrain);
     terrain_grid.items[grid_offset] |= terrain;
 }
 
 void map_terrain_remove(int grid_offset, int terrain)
 {
+    check_road_network_change(grid_offset, terrain_grid.items[grid_offset] & ~terrain);
     terrain_grid.items[grid_offset] &= ~terrain;
 }
 
@@ -77,6 +91,9 @@ void map_terrain_remove_with_radius(int x, int y, int size, int radius, int terr
 
 void map_terrain_remove_all(int terrain)
 {
+    if (terrain & ROAD_NETWORK_TERRAIN) {
+        map_road_network_invalidate();
+    }
     map_grid_and_u32(terrain_grid.items, ~terrain);
 }
 
@@ -398,11 +415,13 @@ void map_terrain_backup(void)
 
 void map_terrain_restore(void)
 {
+    map_road_network_invalidate();
     map_grid_copy_u32(terrain_grid_backup.items, terrain_grid.items);
 }
 
 void map_terrain_clear(void)
 {
+    map_road_network_invalidate();
     map_grid_clear_u32(terrain_grid.items);
 }
 
@@ -471,6 +490,7 @@ static void determine_original_trees(buffer *images, int legacy_buffer)
 
 void map_terrain_load_state(buffer *buf, int expanded_terrain_data, buffer *images, int legacy_image_buffer)
 {
+    map_road_network_invalidate();
     if (expanded_terrain_data) {
         map_grid_load_state_u32(terrain_grid.items, buf);
     } else {
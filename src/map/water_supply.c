@@ -6,6 +6,7 @@
 #include "building/monument.h"
 #include "building/list.h"
 #include "core/image.h"
+#include "core/jobs.h"
 #include "map/aqueduct.h"
 #include "map/building_tiles.h"
 #include "map/data.h"
@@ -27,6 +28,8 @@
 #define WELL_RADIUS 2
 #define FOUNTAIN_RADIUS 4
 
+#define MIN_BUILDINGS_PER_JOB_PART 1000
+
 static const int ADJACENT_OFFSETS[] = { -GRID_SIZE, 1, GRID_SIZE, -1 };
 static const int CONNECTOR_OFFSETS[] = { OFFSET(1,-1), OFFSET(3,1), OFFSET(1,3), OFFSET(-1,1) };
 
@@ -52,21 +55,27 @@ static void mark_well_access(int well_id, int radius)
     }
 }
 
-void map_water_supply_update_buildings(void)
+static void update_house_water_job(int part, int first, int last, void *userdata)
 {
-    for (building_type type = BUILDING_HOUSE_SMALL_TENT; type <= BUILDING_HOUSE_LUXURY_PALACE; type++) {
-        for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-            if (b->state != BUILDING_STATE_IN_USE || !b->house_size) {
-                continue;
-            }
-            b->has_water_access = 0;
-            b->has_well_access = 0;
-            if (map_terrain_exists_tile_in_area_with_type(
-                b->x, b->y, b->size, TERRAIN_FOUNTAIN_RANGE)) {
-                b->has_water_access = 1;
-            }
+    for (int i = first; i < last; i++) {
+        building *b = building_get(i);
+        if (b->state != BUILDING_STATE_IN_USE || !b->house_size ||
+            b->type < BUILDING_HOUSE_SMALL_TENT || b->type > BUILDING_HOUSE_LUXURY_PALACE) {
+            continue;
+        }
+        b->has_water_access = 0;
+        b->has_well_access = 0;
+        if (map_terrain_exists_tile_in_area_with_type(
+            b->x, b->y, b->size, TERRAIN_FOUNTAIN_RANGE)) {
+            b->has_water_access = 1;
         }
     }
+}
+
+void map_water_supply_update_buildings(void)
+{
+    // Houses only read the terrain and write their own flags, wells are marked afterwards
+    jobs_run(building_count(), MIN_BUILDINGS_PER_JOB_PART, update_house_water_job, 0);
 
     for (building *b = building_first_of_type(BUILDING_CONCRETE_MAKER); b; b = b->next_of_type) {
         b->has_well_access = 0;
@@ -8,8 +8,16 @@
 #define DISPLAY_SCALE_ERROR_MESSAGE "Option --display-scale must be followed by a scale value between 0.5 and 5"
 #define WINDOWED_AND_FULLSCREEN_ERROR_MESSAGE "Option --windowed and --fullscreen cannot both be specified"
 #define DISPLAY_ID_ERROR_MESSAGE "Option --display must be followed by a number indicating the display, starting from 0"
+#define LOAD_ERROR_MESSAGE "Option --load must be followed by the path to a saved game"
+#define TICKS_ERROR_MESSAGE "Option --ticks must be followed by a number of ticks greater than 0"
+#define HEADLESS_ERROR_MESSAGE "Option --headless requires --load, and --ticks requires --headless"
+#define RECORD_ERROR_MESSAGE "Option --record must be followed by the path of the replay file to write"
+#define REPLAY_ERROR_MESSAGE "Option --replay must be followed by the path of a recorded replay file"
+#define RECORD_AND_REPLAY_ERROR_MESSAGE "Options --record and --replay require --load and cannot both be specified"
 #define UNKNOWN_OPTION_ERROR_MESSAGE "Option %s not recognized"
 
+#define DEFAULT_HEADLESS_TICKS 10000
+
 static void print_log(const char *message)
 {
     printf("%s\n", message);
@@ -74,6 +82,11 @@ int platform_parse_arguments(int argc, char **argv, augustus_args *output_args)
     output_args->use_software_cursor = 0;
     output_args->force_fullscreen = 0;
     output_args->display_id = 0;
+    output_args->headless = 0;
+    output_args->load_file = 0;
+    output_args->ticks = 0;
+    output_args->record_file = 0;
+    output_args->replay_file = 0;
 
     for (int i = 1; i < argc; i++) {
         // we ignore "-psn" arguments, this is needed to launch the app
@@ -118,6 +131,44 @@ int platform_parse_arguments(int argc, char **argv, augustus_args *output_args)
                 print_log(DISPLAY_ID_ERROR_MESSAGE);
                 ok = 0;
             }
+        } else if (SDL_strcmp(argv[i], "--load") == 0) {
+            if (i + 1 < argc) {
+                output_args->load_file = argv[i + 1];
+                i++;
+            } else {
+                print_log(LOAD_ERROR_MESSAGE);
+                ok = 0;
+            }
+        } else if (SDL_strcmp(argv[i], "--ticks") == 0) {
+            if (i + 1 < argc) {
+                output_args->ticks = SDL_strtol(argv[i + 1], 0, 10);
+                i++;
+                if (output_args->ticks <= 0) {
+                    print_log(TICKS_ERROR_MESSAGE);
+                    ok = 0;
+                }
+            } else {
+                print_log(TICKS_ERROR_MESSAGE);
+                ok = 0;
+            }
+        } else if (SDL_strcmp(argv[i], "--record") == 0) {
+            if (i + 1 < argc) {
+                output_args->record_file = argv[i + 1];
+                i++;
+            } else {
+                print_log(RECORD_ERROR_MESSAGE);
+                ok = 0;
+            }
+        } else if (SDL_strcmp(argv[i], "--replay") == 0) {
+            if (i + 1 < argc) {
+                output_args->replay_file = argv[i + 1];
+                i++;
+            } else {
+                print_log(REPLAY_ERROR_MESSAGE);
+                ok = 0;
+            }
+        } else if (SDL_strcmp(argv[i], "--headless") == 0) {
+            output_args->headless = 1;
         } else if (SDL_strcmp(argv[i], "--windowed") == 0) {
             output_args->force_windowed = 1;
         } else if (SDL_strcmp(argv[i], "--asset-previewer") == 0) {
@@ -142,6 +193,18 @@ int platform_parse_arguments(int argc, char **argv, augustus_args *output_args)
         print_log(WINDOWED_AND_FULLSCREEN_ERROR_MESSAGE);
         ok = 0;
     }
+    if ((output_args->headless && !output_args->load_file) || (output_args->ticks && !output_args->headless)) {
+        print_log(HEADLESS_ERROR_MESSAGE);
+        ok = 0;
+    }
+    if ((output_args->record_file || output_args->replay_file) &&
+        (!output_args->load_file || (output_args->record_file && output_args->replay_file))) {
+        print_log(RECORD_AND_REPLAY_ERROR_MESSAGE);
+        ok = 0;
+    }
+    if (output_args->headless && !output_args->ticks) {
+        output_args->ticks = DEFAULT_HEADLESS_TICKS;
+    }
 
     if (!ok) {
         if (add_blank_line) {
@@ -165,6 +228,17 @@ int platform_parse_arguments(int argc, char **argv, augustus_args *output_args)
         print_log("          Enables joystick support");
         print_log("--software-cursor");
         print_log("          Uses a software cursor instead of the default hardware cursor");
+        print_log("--headless --load FILE [--ticks NUMBER]");
+        print_log("          Runs NUMBER ticks of the saved game FILE as fast as possible without a window");
+        print_log("          and prints the simulation speed. Defaults to 10000 ticks");
+        print_log("--load FILE");
+        print_log("          Loads the saved game FILE on startup instead of showing the main menu");
+        print_log("--record REPLAY");
+        print_log("          Together with --load, writes the player input and a hash of the game state");
+        print_log("          at the end of every day to REPLAY");
+        print_log("--replay REPLAY");
+        print_log("          Together with --load, plays back the input from REPLAY and reports the first day");
+        print_log("          and savegame piece where the game state differs from the recording");
         print_log("The last argument, if present, is interpreted as data directory for the Caesar 3 installation");
     }
     return ok;
@@ -11,6 +11,11 @@ typedef struct {
     int use_software_cursor;
     int force_fullscreen;
     int display_id;
+    int headless;
+    const char *load_file;
+    int ticks;
+    const char *record_file;
+    const char *replay_file;
 } augustus_args;
 
 int platform_parse_arguments(int argc, char **argv, augustus_args *output_args);
@@ -6,9 +6,12 @@
 #include "core/lang.h"
 #include "core/log.h"
 #include "core/time.h"
+#include "game/file.h"
 #include "game/game.h"
+#include "game/replay.h"
 #include "game/settings.h"
 #include "game/system.h"
+#include "game/tick_profiler.h"
 #include "graphics/screen.h"
 #include "graphics/window.h"
 #include "input/mouse.h"
@@ -19,6 +22,7 @@
 #include "platform/emscripten/emscripten.h"
 #include "platform/file_manager.h"
 #include "platform/file_manager_cache.h"
+#include "platform/headless.h"
 #include "platform/ios/ios.h"
 #include "platform/joystick.h"
 #include "platform/keyboard_input.h"
@@ -30,6 +34,7 @@
 #include "platform/touch.h"
 #include "platform/vita/vita.h"
 #include "window/asset_previewer.h"
+#include "window/city.h"
 
 #include "tinyfiledialogs/tinyfiledialogs.h"
 
@@ -188,6 +193,15 @@ uint64_t system_get_ticks(void)
 #endif
 }
 
+uint64_t system_get_microseconds(void)
+{
+    static uint64_t frequency;
+    if (!frequency) {
+        frequency = SDL_GetPerformanceFrequency();
+    }
+    return (uint64_t) (SDL_GetPerformanceCounter() * 1000000.0 / frequency);
+}
+
 #ifdef _WIN32
 #define PLATFORM_ENABLE_PER_FRAME_CALLBACK
 static void platform_per_frame_callback(void)
@@ -215,6 +229,9 @@ static void run_and_draw(void)
     if (config_get(CONFIG_UI_DISPLAY_FPS)) {
         game_display_fps(data.fps.last_fps);
     }
+    if (tick_profiler_is_enabled()) {
+        game_display_tick_profiler();
+    }
 
     platform_renderer_render();
 }
@@ -265,6 +282,10 @@ static void handle_window_event(SDL_WindowEvent *event, int *window_active)
             SDL_Log("Window %u hidden", (unsigned int) event->windowID);
             *window_active = 0;
             break;
+        case SDL_WINDOWEVENT_MINIMIZED:
+            // Nothing is drawn while minimized, the cached layers are drawn again when needed
+            platform_renderer_free_layers();
+            break;
 
         case SDL_WINDOWEVENT_EXPOSED:
             SDL_Log("Window %u exposed", (unsigned int) event->windowID);
@@ -694,6 +715,20 @@ static void setup(const augustus_args *args)
     data.active = 1;
 }
 
+static void load_game_from_arguments(const augustus_args *args)
+{
+    if (game_file_load_saved_game(args->load_file) != FILE_LOAD_SUCCESS) {
+        SDL_Log("Unable to load saved game %s", args->load_file);
+        return;
+    }
+    window_city_show();
+    if (args->record_file) {
+        game_replay_start_recording(args->record_file);
+    } else if (args->replay_file) {
+        game_replay_start_playback(args->replay_file);
+    }
+}
+
 int main(int argc, char **argv)
 {
     augustus_args args;
@@ -704,9 +739,15 @@ int main(int argc, char **argv)
 #endif
     }
 
-    setup(&args);
+    if (args.headless) {
+        return platform_headless_run(&args);
+    }
 
+    setup(&args);
 
+    if (args.load_file && !args.launch_asset_previewer) {
+        load_game_from_arguments(&args);
+    }
 
     mouse_set_inside_window(1);
     run_and_draw();
@@ -452,6 +452,20 @@ int platform_file_manager_should_case_correct_file(void)
 #endif
 }
 
+int platform_file_manager_get_modified_time(const char *path, long *modified_time)
+{
+    const file_name *name = set_file_name(path);
+    stat_info file_info;
+#ifdef _WIN32
+    int exists = _wstat(name, &file_info) != -1;
+#else
+    int exists = stat(name, &file_info) != -1;
+#endif
+    free_file_name(name);
+    *modified_time = exists ? (long) file_info.st_mtime : 0;
+    return exists;
+}
+
 int platform_file_manager_filename_contains(const char *filename, const char *expression)
 {
     int has_filename = filename && *filename;
@@ -632,6 +646,15 @@ int platform_file_manager_remove_file(const char *filename)
     return android_remove_file(filename);
 }
 
+int platform_file_manager_rename_file(const char *src, const char *dst)
+{
+    // Content URIs cannot be renamed in place
+    if (!platform_file_manager_copy_file(src, dst)) {
+        return 0;
+    }
+    return android_remove_file(src);
+}
+
 #else
 
 FILE *platform_file_manager_open_file(const char *filename, const char *mode)
@@ -675,6 +698,33 @@ int platform_file_manager_remove_file(const char *filename)
     return result == 0;
 }
 
+int platform_file_manager_rename_file(const char *src, const char *dst)
+{
+#ifdef USE_FILE_CACHE
+    platform_file_manager_cache_delete_file_info(src);
+#endif
+#ifdef _WIN32
+    wchar_t *wsrc = utf8_to_wchar(src);
+    wchar_t *wdst = utf8_to_wchar(dst);
+    int result = MoveFileExW(wsrc, wdst, MOVEFILE_REPLACE_EXISTING) != 0;
+    free(wsrc);
+    free(wdst);
+#else
+    int result = rename(src, dst) == 0;
+#endif
+#ifdef USE_FILE_CACHE
+    platform_file_manager_cache_update_file_info(dst);
+#endif
+#if defined(__EMSCRIPTEN__)
+    if (result) {
+        EM_ASM(
+            Module.syncFS();
+        );
+    }
+#endif
+    return result;
+}
+
 FILE *platform_file_manager_open_asset(const char *asset, const char *mode)
 {
     const char *cased_asset_path = dir_get_file_at_location(asset, PATH_LOCATION_ASSET);
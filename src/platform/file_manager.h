@@ -58,6 +58,14 @@ int platform_file_manager_list_directory_contents(
  */
 int platform_file_manager_should_case_correct_file(void);
 
+/**
+ * Gets the last time a file or directory was modified
+ * @param path The path of the file or directory
+ * @param modified_time Gets the modification time, in seconds
+ * @return 1 if the file or directory exists, 0 otherwise
+ */
+int platform_file_manager_get_modified_time(const char *path, long *modified_time);
+
 /**
  * Checks whether a filename contains a string
  * @param filename Filename to check
@@ -115,6 +123,14 @@ int platform_file_manager_close_file(FILE *stream);
  */
 int platform_file_manager_remove_file(const char *filename);
 
+/**
+ * Renames a file, replacing the destination if it exists
+ * @param src The file to rename
+ * @param dst The new name of the file
+ * @return 1 if renaming was successful, 0 otherwise
+ */
+int platform_file_manager_rename_file(const char *src, const char *dst);
+
 /**
  * Creates a directory
  * @param name The full path to the new directory
@@ -0,0 +1,362 @@
+#include "headless.h"
+
+#include "SDL.h"
+
+#include "core/jobs.h"
+#include "core/time.h"
+#include "game/file.h"
+#include "game/game.h"
+#include "game/replay.h"
+#include "game/system.h"
+#include "game/tick.h"
+#include "game/tick_profiler.h"
+#include "graphics/renderer.h"
+#include "graphics/window.h"
+#include "platform/file_manager.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_ATLAS_IMAGE_SIZE 4096
+#define MAX_PACKED_IMAGE_SIZE 64000
+#define TICKS_PER_DAY 50
+
+// The images are still loaded because the simulation uses their ids and sizes, so the atlases keep their buffers
+static struct {
+    image_atlas_data atlas_data[ATLAS_MAX];
+    int has_atlas[ATLAS_MAX];
+    graphics_renderer_interface renderer_interface;
+} data;
+
+static void noop(void)
+{}
+
+static void noop_rect(int x, int y, int width, int height)
+{}
+
+static void noop_line(int x_start, int x_end, int y_start, int y_end, color_t color)
+{}
+
+static void noop_draw_image(const image *img, int x, int y, color_t color, float scale)
+{}
+
+static void noop_draw_image_advanced(const image *img, float x, float y, color_t color,
+    float scale_x, float scale_y, double angle, int disable_coord_scaling)
+{}
+
+static void noop_create_custom_image(custom_image_type type, int width, int height, int is_yuv)
+{}
+
+static int noop_has_custom_image(custom_image_type type)
+{
+    return 0;
+}
+
+static color_t *noop_get_custom_image_buffer(custom_image_type type, int *actual_texture_width)
+{
+    return 0;
+}
+
+static void noop_custom_image(custom_image_type type)
+{}
+
+static void noop_update_custom_image_from(custom_image_type type, const color_t *buffer,
+    int x_offset, int y_offset, int width, int height)
+{}
+
+static void noop_update_custom_image_yuv(custom_image_type type, const uint8_t *y_data, int y_width,
+    const uint8_t *cb_data, int cb_width, const uint8_t *cr_data, int cr_width)
+{}
+
+static void noop_draw_custom_image(custom_image_type type, int x, int y, float scale, int disable_filtering)
+{}
+
+static int return_zero(void)
+{
+    return 0;
+}
+
+static int noop_start_tooltip_creation(int width, int height)
+{
+    return 0;
+}
+
+static void noop_set_tooltip_value(int value)
+{}
+
+static void noop_set_tooltip_position(int x, int y)
+{}
+
+static int noop_save_image_from_screen(int image_id, int x, int y, int width, int height)
+{
+    return 0;
+}
+
+static void noop_draw_image_to_screen(int image_id, int x, int y)
+{}
+
+static int noop_save_screen_buffer(color_t *pixels, int x, int y, int width, int height, int row_width)
+{
+    return 0;
+}
+
+static int noop_start_layer_creation(int layer_id, int width, int height)
+{
+    return 0;
+}
+
+static int noop_draw_layer(int layer_id, int x, int y, float scale)
+{
+    return 0;
+}
+
+static void noop_free_layer(int layer_id)
+{}
+
+static void get_max_image_size(int *width, int *height)
+{
+    *width = MAX_ATLAS_IMAGE_SIZE;
+    *height = MAX_ATLAS_IMAGE_SIZE;
+}
+
+static void free_atlas(atlas_type type)
+{
+    image_atlas_data *atlas_data = &data.atlas_data[type];
+    if (atlas_data->buffers) {
+        for (int i = 0; i < atlas_data->num_images; i++) {
+            free(atlas_data->buffers[i]);
+        }
+    }
+    free(atlas_data->buffers);
+    free(atlas_data->image_widths);
+    free(atlas_data->image_heights);
+    atlas_data->buffers = 0;
+    atlas_data->image_widths = 0;
+    atlas_data->image_heights = 0;
+    atlas_data->num_images = 0;
+    atlas_data->type = type;
+    data.has_atlas[type] = 0;
+}
+
+static const image_atlas_data *prepare_atlas(atlas_type type, int num_images, int last_width, int last_height)
+{
+    free_atlas(type);
+    image_atlas_data *atlas_data = &data.atlas_data[type];
+    atlas_data->num_images = num_images;
+    atlas_data->image_widths = malloc(sizeof(int) * num_images);
+    atlas_data->image_heights = malloc(sizeof(int) * num_images);
+    atlas_data->buffers = malloc(sizeof(color_t *) * num_images);
+    if (!atlas_data->image_widths || !atlas_data->image_heights || !atlas_data->buffers) {
+        free_atlas(type);
+        return 0;
+    }
+    memset(atlas_data->buffers, 0, sizeof(color_t *) * num_images);
+    for (int i = 0; i < num_images; i++) {
+        atlas_data->image_widths[i] = i == num_images - 1 ? last_width : MAX_ATLAS_IMAGE_SIZE;
+        atlas_data->image_heights[i] = i == num_images - 1 ? last_height : MAX_ATLAS_IMAGE_SIZE;
+        size_t size = sizeof(color_t) * atlas_data->image_widths[i] * atlas_data->image_heights[i];
+        atlas_data->buffers[i] = malloc(size);
+        if (!atlas_data->buffers[i]) {
+            free_atlas(type);
+            return 0;
+        }
+        memset(atlas_data->buffers[i], 0, size);
+    }
+    return atlas_data;
+}
+
+static int create_atlas(const image_atlas_data *atlas_data, int delete_buffers)
+{
+    if (!atlas_data || atlas_data != &data.atlas_data[atlas_data->type] || !atlas_data->num_images) {
+        return 0;
+    }
+    data.has_atlas[atlas_data->type] = 1;
+    if (delete_buffers) {
+        for (int i = 0; i < atlas_data->num_images; i++) {
+            free(atlas_data->buffers[i]);
+            atlas_data->buffers[i] = 0;
+        }
+    }
+    return 1;
+}
+
+static const image_atlas_data *get_atlas(atlas_type type)
+{
+    return data.has_atlas[type] ? &data.atlas_data[type] : 0;
+}
+
+static int has_atlas(atlas_type type)
+{
+    return data.has_atlas[type];
+}
+
+static void noop_load_unpacked_image(const image *img, const color_t *pixels)
+{}
+
+static void noop_free_unpacked_image(const image *img)
+{}
+
+static int should_pack_image(int width, int height)
+{
+    return width * height < MAX_PACKED_IMAGE_SIZE;
+}
+
+static void noop_update_scale(int city_scale)
+{}
+
+static void set_null_renderer(void)
+{
+    graphics_renderer_interface *renderer = &data.renderer_interface;
+    renderer->clear_screen = noop;
+    renderer->set_viewport = noop_rect;
+    renderer->reset_viewport = noop;
+    renderer->set_clip_rectangle = noop_rect;
+    renderer->reset_clip_rectangle = noop;
+    renderer->draw_line = noop_line;
+    renderer->draw_rect = noop_line;
+    renderer->fill_rect = noop_line;
+    renderer->draw_image = noop_draw_image;
+    renderer->draw_image_advanced = noop_draw_image_advanced;
+    renderer->draw_silhouette = noop_draw_image;
+    renderer->create_custom_image = noop_create_custom_image;
+    renderer->has_custom_image = noop_has_custom_image;
+    renderer->get_custom_image_buffer = noop_get_custom_image_buffer;
+    renderer->release_custom_image_buffer = noop_custom_image;
+    renderer->update_custom_image = noop_custom_image;
+    renderer->update_custom_image_from = noop_update_custom_image_from;
+    renderer->update_custom_image_yuv = noop_update_custom_image_yuv;
+    renderer->draw_custom_image = noop_draw_custom_image;
+    renderer->supports_yuv_image_format = return_zero;
+    renderer->start_tooltip_creation = noop_start_tooltip_creation;
+    renderer->finish_tooltip_creation = noop;
+    renderer->has_tooltip = return_zero;
+    renderer->set_tooltip_position = noop_set_tooltip_position;
+    renderer->set_tooltip_opacity = noop_set_tooltip_value;
+    renderer->save_image_from_screen = noop_save_image_from_screen;
+    renderer->draw_image_to_screen = noop_draw_image_to_screen;
+    renderer->save_screen_buffer = noop_save_screen_buffer;
+    renderer->start_layer_creation = noop_start_layer_creation;
+    renderer->finish_layer_creation = noop;
+    renderer->draw_layer = noop_draw_layer;
+    renderer->free_layer = noop_free_layer;
+    renderer->get_max_image_size = get_max_image_size;
+    renderer->prepare_image_atlas = prepare_atlas;
+    renderer->create_image_atlas = create_atlas;
+    renderer->get_image_atlas = get_atlas;
+    renderer->has_image_atlas = has_atlas;
+    renderer->free_image_atlas = free_atlas;
+    renderer->load_unpacked_image = noop_load_unpacked_image;
+    renderer->free_unpacked_image = noop_free_unpacked_image;
+    renderer->should_pack_image = should_pack_image;
+    renderer->update_scale = noop_update_scale;
+
+    graphics_renderer_set_interface(renderer);
+}
+
+static int compare_stats(const void *a, const void *b)
+{
+    uint64_t total_a = ((const tick_profiler_stats *) a)->total_micros;
+    uint64_t total_b = ((const tick_profiler_stats *) b)->total_micros;
+    return total_a < total_b ? 1 : total_a > total_b ? -1 : 0;
+}
+
+static void print_group(tick_profiler_group group, const char *title, uint64_t elapsed_micros)
+{
+    int num_sections = tick_profiler_num_sections(group);
+    tick_profiler_stats *stats = malloc(sizeof(tick_profiler_stats) * num_sections);
+    if (!stats) {
+        return;
+    }
+    int used = 0;
+    for (int i = 0; i < num_sections; i++) {
+        tick_profiler_get_stats(group, i, &stats[used]);
+        if (stats[used].count) {
+            used++;
+        }
+    }
+    if (!used) {
+        free(stats);
+        return;
+    }
+    qsort(stats, used, sizeof(tick_profiler_stats), compare_stats);
+
+    printf("\n%-30s %10s %6s %10s %10s %8s\n", title, "Total ms", "%", "Avg us", "Max us", "Runs");
+    for (int i = 0; i < used; i++) {
+        const tick_profiler_stats *s = &stats[i];
+        printf("%-30s %10.2f %6.2f %10.1f %10lu %8d\n", tick_profiler_section_name(group, s->section),
+            s->total_micros / 1000.0,
+            elapsed_micros ? 100.0 * s->total_micros / elapsed_micros : 0.0,
+            (double) s->total_micros / s->count,
+            (unsigned long) s->max_micros, s->count);
+    }
+    free(stats);
+}
+
+static void print_timings(int ticks, uint64_t elapsed_micros)
+{
+    double seconds = elapsed_micros / 1000000.0;
+    printf("Ran %d ticks (%d days) in %.3f seconds: %.1f ticks per second\n",
+        ticks, ticks / TICKS_PER_DAY, seconds, seconds > 0 ? ticks / seconds : 0.0);
+
+    print_group(TICK_PROFILER_PHASE, "Phase", elapsed_micros);
+    print_group(TICK_PROFILER_CALENDAR, "Calendar step", elapsed_micros);
+    print_group(TICK_PROFILER_FIGURE, "Figure type", elapsed_micros);
+}
+
+int platform_headless_run(const augustus_args *args)
+{
+    static const window_type window = { WINDOW_HEADLESS };
+
+    if (args->data_directory && !platform_file_manager_set_base_path(args->data_directory)) {
+        SDL_Log("%s: directory not found", args->data_directory);
+        return 1;
+    }
+    if (!game_pre_init()) {
+        SDL_Log("Exiting: game pre-init failed");
+        return 1;
+    }
+    set_null_renderer();
+    time_set_millis(system_get_ticks());
+    if (!game_init_headless()) {
+        SDL_Log("Exiting: game init failed");
+        return 2;
+    }
+    window_show(&window);
+
+    if (game_file_load_saved_game(args->load_file) != FILE_LOAD_SUCCESS) {
+        SDL_Log("Exiting: unable to load saved game %s", args->load_file);
+        return 3;
+    }
+
+    if (args->record_file && !game_replay_start_recording(args->record_file)) {
+        return 3;
+    }
+    if (args->replay_file && !game_replay_start_playback(args->replay_file)) {
+        return 3;
+    }
+
+    // Benchmark and test runs must not overwrite the player's autosaves
+    game_tick_set_autosaves_enabled(0);
+    tick_profiler_reset();
+    tick_profiler_set_enabled(1);
+    uint64_t start = system_get_microseconds();
+    int ticks = 0;
+    while (ticks < args->ticks) {
+        game_tick_run();
+        ticks++;
+        if (args->replay_file && (!game_replay_is_playing() || game_replay_has_diverged())) {
+            break;
+        }
+    }
+    uint64_t elapsed = system_get_microseconds() - start;
+    tick_profiler_set_enabled(0);
+
+    print_timings(ticks, elapsed);
+
+    game_replay_stop();
+    game_file_finish_background_saves();
+    game_tick_set_autosaves_enabled(1);
+    jobs_shutdown();
+    return game_replay_has_diverged() ? 4 : 0;
+}
@@ -0,0 +1,13 @@
+#ifndef PLATFORM_HEADLESS_H
+#define PLATFORM_HEADLESS_H
+
+#include "platform/arguments.h"
+
+/**
+ * Runs the simulation of a saved game without a window, renderer or sound and prints the timings
+ * @param args The command line arguments, with the saved game and number of ticks to run
+ * @return Exit code of the program
+ */
+int platform_headless_run(const augustus_args *args);
+
+#endif // PLATFORM_HEADLESS_H
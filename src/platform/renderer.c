@@ -23,6 +23,11 @@
 #define HAS_YUV_TEXTURES 0
 #endif
 
+#if SDL_VERSION_ATLEAST(2, 0, 6)
+#define USE_CUSTOM_BLEND_MODE
+#define HAS_CUSTOM_BLEND_MODE (platform_sdl_version_at_least(2, 0, 6))
+#endif
+
 #if SDL_VERSION_ATLEAST(2, 0, 10)
 #define USE_RENDERCOPYF
 #define HAS_RENDERCOPYF (platform_sdl_version_at_least(2, 0, 10))
@@ -35,10 +40,17 @@
 #define HAS_TEXTURE_SCALE_MODE 0
 #endif
 
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+#define USE_RENDER_GEOMETRY
+#define HAS_RENDER_GEOMETRY (platform_sdl_version_at_least(2, 0, 18))
+#endif
+
 #define MAX_UNPACKED_IMAGES 20
 
 #define MAX_PACKED_IMAGE_SIZE 64000
 
+#define MAX_BATCHED_QUADS 2048
+
 #if (defined(__ANDROID__) || defined(__EMSCRIPTEN__)) && !SDL_VERSION_ATLEAST(2, 24, 0)
 // On the arm versions of android, on SDL < 2.24.0, atlas textures that are too large will make the renderer fetch
 // some images from the atlas with an off-by-one pixel, making things look terrible. Defining a smaller atlas texture
@@ -107,6 +119,15 @@ static struct {
         buffer_texture *last;
         int current_id;
     } texture_buffers;
+    struct {
+        buffer_texture *first;
+        buffer_texture *last;
+        int current_id;
+        int is_creating;
+        SDL_Texture *former_target;
+        SDL_Rect former_viewport;
+        SDL_Rect former_clip;
+    } layers;
     silhouette_texture *silhouettes;
     struct {
         int id;
@@ -118,13 +139,60 @@ static struct {
     float city_scale;
     int should_correct_texture_offset;
     int disable_linear_filter;
+#ifdef USE_RENDER_GEOMETRY
+    struct {
+        int enabled;
+        SDL_Texture *texture;
+        SDL_ScaleMode scale_mode;
+        float texture_width;
+        float texture_height;
+        int num_quads;
+        SDL_Vertex vertices[MAX_BATCHED_QUADS * 4];
+        int indices[MAX_BATCHED_QUADS * 6];
+    } batch;
+#endif
 } data;
 
+static void init_batch(void)
+{
+#ifdef USE_RENDER_GEOMETRY
+    // The software renderer rasterizes geometry per pixel, which is slower than its blitter
+    data.batch.enabled = HAS_RENDER_GEOMETRY && !data.is_software_renderer;
+    data.batch.texture = 0;
+    data.batch.num_quads = 0;
+    for (int i = 0; i < MAX_BATCHED_QUADS; i++) {
+        int *indices = &data.batch.indices[i * 6];
+        int first_vertex = i * 4;
+        indices[0] = first_vertex;
+        indices[1] = first_vertex + 1;
+        indices[2] = first_vertex + 2;
+        indices[3] = first_vertex + 2;
+        indices[4] = first_vertex + 1;
+        indices[5] = first_vertex + 3;
+    }
+#endif
+}
+
+// Must be called before anything else is drawn and before the render target, viewport, clip rectangle
+// or an atlas texture change, so the batched images are drawn in the right order and place
+static void flush_batch(void)
+{
+#ifdef USE_RENDER_GEOMETRY
+    if (data.batch.num_quads) {
+        SDL_RenderGeometry(data.renderer, data.batch.texture, data.batch.vertices, data.batch.num_quads * 4,
+            data.batch.indices, data.batch.num_quads * 6);
+        data.batch.num_quads = 0;
+    }
+    data.batch.texture = 0;
+#endif
+}
+
 static int save_screen_buffer(color_t *pixels, int x, int y, int width, int height, int row_width)
 {
     if (data.paused) {
         return 0;
     }
+    flush_batch();
     SDL_Rect rect = { x, y, width, height };
     return SDL_RenderReadPixels(data.renderer, &rect, SDL_PIXELFORMAT_ARGB8888, pixels,
         row_width * sizeof(color_t)) == 0;
@@ -135,6 +203,7 @@ static void draw_line(int x_start, int x_end, int y_start, int y_end, color_t co
     if (data.paused) {
         return;
     }
+    flush_batch();
     SDL_SetRenderDrawColor(data.renderer,
         (color & COLOR_CHANNEL_RED) >> COLOR_BITSHIFT_RED,
         (color & COLOR_CHANNEL_GREEN) >> COLOR_BITSHIFT_GREEN,
@@ -148,6 +217,7 @@ static void draw_rect(int x_start, int x_end, int y_start, int y_end, color_t co
     if (data.paused) {
         return;
     }
+    flush_batch();
     SDL_SetRenderDrawColor(data.renderer,
         (color & COLOR_CHANNEL_RED) >> COLOR_BITSHIFT_RED,
         (color & COLOR_CHANNEL_GREEN) >> COLOR_BITSHIFT_GREEN,
@@ -162,6 +232,7 @@ static void fill_rect(int x_start, int x_end, int y_start, int y_end, color_t co
     if (data.paused) {
         return;
     }
+    flush_batch();
     SDL_SetRenderDrawColor(data.renderer,
         (color & COLOR_CHANNEL_RED) >> COLOR_BITSHIFT_RED,
         (color & COLOR_CHANNEL_GREEN) >> COLOR_BITSHIFT_GREEN,
@@ -176,6 +247,7 @@ static void set_clip_rectangle(int x, int y, int width, int height)
     if (data.paused) {
         return;
     }
+    flush_batch();
     SDL_Rect clip = { x, y, width, height };
     SDL_RenderSetClipRect(data.renderer, &clip);
 }
@@ -185,6 +257,7 @@ static void reset_clip_rectangle(void)
     if (data.paused) {
         return;
     }
+    flush_batch();
     SDL_RenderSetClipRect(data.renderer, NULL);
 }
 
@@ -193,6 +266,7 @@ static void set_viewport(int x, int y, int width, int height)
     if (data.paused) {
         return;
     }
+    flush_batch();
     SDL_Rect viewport = { x, y, width, height };
     SDL_RenderSetViewport(data.renderer, &viewport);
 }
@@ -202,6 +276,7 @@ static void reset_viewport(void)
     if (data.paused) {
         return;
     }
+    flush_batch();
     SDL_RenderSetViewport(data.renderer, NULL);
     SDL_RenderSetClipRect(data.renderer, NULL);
 }
@@ -211,6 +286,7 @@ static void clear_screen(void)
     if (data.paused) {
         return;
     }
+    flush_batch();
     SDL_SetRenderDrawColor(data.renderer, 0, 0, 0, 0);
     SDL_RenderClear(data.renderer);
 }
@@ -243,11 +319,28 @@ static void free_unpacked_assets(void)
     memset(data.unpacked_images, 0, sizeof(data.unpacked_images));
 }
 
+static void free_layers(void)
+{
+    buffer_texture *layer = data.layers.first;
+    while (layer) {
+        buffer_texture *current = layer;
+        layer = layer->next;
+        if (current->texture) {
+            SDL_DestroyTexture(current->texture);
+        }
+        free(current);
+    }
+    data.layers.first = 0;
+    data.layers.last = 0;
+    // The id is not reset, so the ids that callers still hold are not given to new layers
+}
+
 static void free_texture_atlas(atlas_type type)
 {
     if (!data.texture_lists[type]) {
         return;
     }
+    flush_batch();
     SDL_Texture **list = data.texture_lists[type];
     data.texture_lists[type] = 0;
     for (int i = 0; i < data.atlas_data[type].num_images; i++) {
@@ -260,6 +353,8 @@ static void free_texture_atlas(atlas_type type)
     if (type == ATLAS_EXTRA_ASSET) {
         free_unpacked_assets();
     }
+    // Layers contain images from the atlases, which may change when they are loaded again
+    free_layers();
 }
 
 static void free_atlas_data_buffers(atlas_type type)
@@ -432,6 +527,7 @@ static void free_all_textures(void)
     }
 
     free_silhouettes();
+    free_layers();
 
     if (data.tooltip.texture) {
         SDL_DestroyTexture(data.tooltip.texture);
@@ -472,6 +568,18 @@ static SDL_Texture *get_texture(int texture_id)
     return data.texture_lists[type][texture_id & IMAGE_ATLAS_BIT_MASK];
 }
 
+#ifdef USE_TEXTURE_SCALE_MODE
+static SDL_ScaleMode get_desired_scale_mode(float scale)
+{
+    if (data.disable_linear_filter) {
+        return SDL_ScaleModeNearest;
+    }
+    SDL_ScaleMode city_scale_mode = SDL_ScaleModeNearest;
+    SDL_ScaleMode texture_scale_mode = scale != 1.0f ? SDL_ScaleModeLinear : SDL_ScaleModeNearest;
+    return data.city_scale == scale ? city_scale_mode : texture_scale_mode;
+}
+#endif
+
 static void set_texture_color_and_scale_mode(SDL_Texture *texture, color_t color, float scale)
 {
     if (!color) {
@@ -491,18 +599,73 @@ static void set_texture_color_and_scale_mode(SDL_Texture *texture, color_t color
     SDL_ScaleMode current_scale_mode;
     SDL_GetTextureScaleMode(texture, &current_scale_mode);
 
-    SDL_ScaleMode city_scale_mode = SDL_ScaleModeNearest;
-    SDL_ScaleMode texture_scale_mode = scale != 1.0f ? SDL_ScaleModeLinear : SDL_ScaleModeNearest;
-    SDL_ScaleMode desired_scale_mode = data.city_scale == scale ? city_scale_mode : texture_scale_mode;
-    if (data.disable_linear_filter) {
-        desired_scale_mode = SDL_ScaleModeNearest;
-    }
+    SDL_ScaleMode desired_scale_mode = get_desired_scale_mode(scale);
     if (current_scale_mode != desired_scale_mode) {
         SDL_SetTextureScaleMode(texture, desired_scale_mode);
     }
 #endif
 }
 
+#ifdef USE_RENDER_GEOMETRY
+static int can_batch_texture(int texture_id, double angle)
+{
+    if (!data.batch.enabled || angle != 0.0) {
+        return 0;
+    }
+    // Only packed atlases are batched: the other textures can be updated or freed while they are being drawn
+    atlas_type type = texture_id >> IMAGE_ATLAS_BIT_OFFSET;
+    return type < ATLAS_UNPACKED_EXTRA_ASSET;
+}
+
+static void set_vertex(SDL_Vertex *vertex, float x, float y, SDL_Color color, float u, float v)
+{
+    vertex->position.x = x;
+    vertex->position.y = y;
+    vertex->color = color;
+    vertex->tex_coord.x = u;
+    vertex->tex_coord.y = v;
+}
+
+static void add_to_batch(SDL_Texture *texture, const SDL_Rect *src, const SDL_FRect *dst, color_t color, float scale)
+{
+    SDL_ScaleMode scale_mode = get_desired_scale_mode(scale);
+    if (texture != data.batch.texture || scale_mode != data.batch.scale_mode ||
+        data.batch.num_quads == MAX_BATCHED_QUADS) {
+        flush_batch();
+        // The color is set per vertex, so the texture itself should not change it
+        set_texture_color_and_scale_mode(texture, COLOR_MASK_NONE, scale);
+        int width, height;
+        SDL_QueryTexture(texture, NULL, NULL, &width, &height);
+        data.batch.texture = texture;
+        data.batch.scale_mode = scale_mode;
+        data.batch.texture_width = (float) width;
+        data.batch.texture_height = (float) height;
+    }
+    if (!color) {
+        color = COLOR_MASK_NONE;
+    }
+    SDL_Color vertex_color = {
+        (color & COLOR_CHANNEL_RED) >> COLOR_BITSHIFT_RED,
+        (color & COLOR_CHANNEL_GREEN) >> COLOR_BITSHIFT_GREEN,
+        (color & COLOR_CHANNEL_BLUE) >> COLOR_BITSHIFT_BLUE,
+        (color & COLOR_CHANNEL_ALPHA) >> COLOR_BITSHIFT_ALPHA
+    };
+    float u_start = src->x / data.batch.texture_width;
+    float v_start = src->y / data.batch.texture_height;
+    float u_end = (src->x + src->w) / data.batch.texture_width;
+    float v_end = (src->y + src->h) / data.batch.texture_height;
+    float x_end = dst->x + dst->w;
+    float y_end = dst->y + dst->h;
+
+    SDL_Vertex *vertices = &data.batch.vertices[data.batch.num_quads * 4];
+    set_vertex(&vertices[0], dst->x, dst->y, vertex_color, u_start, v_start);
+    set_vertex(&vertices[1], x_end, dst->y, vertex_color, u_end, v_start);
+    set_vertex(&vertices[2], dst->x, y_end, vertex_color, u_start, v_end);
+    set_vertex(&vertices[3], x_end, y_end, vertex_color, u_end, v_end);
+    data.batch.num_quads++;
+}
+#endif
+
 static void draw_texture_advanced(const image *img, float x, float y, color_t color,
     float scale_x, float scale_y, double angle, int disable_coord_scaling)
 {
@@ -518,7 +681,15 @@ static void draw_texture_advanced(const image *img, float x, float y, color_t co
 
     float scale = scale_x == scale_y ? scale_x : 0.0f;
 
+#ifdef USE_RENDER_GEOMETRY
+    int batched = can_batch_texture(img->atlas.id, angle);
+    if (!batched) {
+        flush_batch();
+        set_texture_color_and_scale_mode(texture, color, scale);
+    }
+#else
     set_texture_color_and_scale_mode(texture, color, scale);
+#endif
 
     x += img->x_offset;
     y += img->y_offset;
@@ -544,6 +715,12 @@ static void draw_texture_advanced(const image *img, float x, float y, color_t co
             (img->width - grid_correction) / scale_x,
             (img->height - grid_correction) / scale_y
         };
+#ifdef USE_RENDER_GEOMETRY
+        if (batched) {
+            add_to_batch(texture, &src_coords, &dst_coords, color, scale);
+            return;
+        }
+#endif
         SDL_RenderCopyExF(data.renderer, texture, &src_coords, &dst_coords, angle, NULL, SDL_FLIP_NONE);
         return;
     }
@@ -691,6 +868,7 @@ static int start_tooltip_creation(int width, int height)
     if (data.paused) {
         return 0;
     }
+    flush_batch();
     if (data.tooltip.texture) {
         if (data.tooltip.texture_width < width || data.tooltip.texture_height < height) {
             SDL_DestroyTexture(data.tooltip.texture);
@@ -728,6 +906,7 @@ static void finish_tooltip_creation(void)
     if (data.paused) {
         return;
     }
+    flush_batch();
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "nearest");
     SDL_SetRenderTarget(data.renderer, data.render_texture);
 }
@@ -748,12 +927,12 @@ static void set_tooltip_opacity(int opacity)
     data.tooltip.opacity = calc_adjust_with_percentage(255, opacity);
 }
 
-static buffer_texture *get_saved_texture_info(int texture_id)
+static buffer_texture *find_buffer_texture(buffer_texture *first, int texture_id)
 {
-    if (!texture_id || !data.texture_buffers.first) {
+    if (!texture_id) {
         return 0;
     }
-    for (buffer_texture *texture_info = data.texture_buffers.first; texture_info; texture_info = texture_info->next) {
+    for (buffer_texture *texture_info = first; texture_info; texture_info = texture_info->next) {
         if (texture_info->id == texture_id) {
             return texture_info;
         }
@@ -761,11 +940,17 @@ static buffer_texture *get_saved_texture_info(int texture_id)
     return 0;
 }
 
+static buffer_texture *get_saved_texture_info(int texture_id)
+{
+    return find_buffer_texture(data.texture_buffers.first, texture_id);
+}
+
 static int save_to_texture(int texture_id, int x, int y, int width, int height)
 {
     if (data.paused) {
         return 0;
     }
+    flush_batch();
     SDL_Texture *former_target = SDL_GetRenderTarget(data.renderer);
     if (!former_target) {
         return 0;
@@ -841,6 +1026,7 @@ static void draw_saved_texture(int texture_id, int x, int y)
     if (data.paused) {
         return;
     }
+    flush_batch();
     buffer_texture *texture_info = get_saved_texture_info(texture_id);
     if (!texture_info) {
         return;
@@ -850,8 +1036,148 @@ static void draw_saved_texture(int texture_id, int x, int y)
     SDL_RenderCopy(data.renderer, texture_info->texture, &src_coords, &dst_coords);
 }
 
+static void set_layer_blend_mode(SDL_Texture *texture)
+{
+#ifdef USE_CUSTOM_BLEND_MODE
+    if (HAS_CUSTOM_BLEND_MODE) {
+        // Images blended onto a transparent layer end up with their colors already multiplied by their alpha
+        SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+            SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+        if (SDL_SetTextureBlendMode(texture, premultiplied) == 0) {
+            return;
+        }
+    }
+#endif
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+}
+
+static buffer_texture *get_layer_for_size(int layer_id, int width, int height)
+{
+    buffer_texture *layer = find_buffer_texture(data.layers.first, layer_id);
+    if (layer && layer->texture && (layer->tex_width < width || layer->tex_height < height)) {
+        SDL_DestroyTexture(layer->texture);
+        layer->texture = 0;
+    }
+    if (!layer) {
+        layer = malloc(sizeof(buffer_texture));
+        if (!layer) {
+            return 0;
+        }
+        memset(layer, 0, sizeof(buffer_texture));
+        layer->id = ++data.layers.current_id;
+        if (!data.layers.first) {
+            data.layers.first = layer;
+        } else {
+            data.layers.last->next = layer;
+        }
+        data.layers.last = layer;
+    }
+    if (!layer->texture) {
+        layer->texture = SDL_CreateTexture(data.renderer, SDL_PIXELFORMAT_ABGR8888, SDL_TEXTUREACCESS_TARGET,
+            width, height);
+        if (!layer->texture) {
+            return 0;
+        }
+        set_layer_blend_mode(layer->texture);
+#ifdef USE_TEXTURE_SCALE_MODE
+        if (HAS_TEXTURE_SCALE_MODE) {
+            SDL_SetTextureScaleMode(layer->texture, SDL_ScaleModeNearest);
+        }
+#endif
+        layer->tex_width = width;
+        layer->tex_height = height;
+    }
+    layer->width = width;
+    layer->height = height;
+    return layer;
+}
+
+static int start_layer_creation(int layer_id, int width, int height)
+{
+    if (data.paused || data.layers.is_creating) {
+        return 0;
+    }
+    flush_batch();
+    buffer_texture *layer = get_layer_for_size(layer_id, width, height);
+    if (!layer) {
+        return 0;
+    }
+    data.layers.former_target = SDL_GetRenderTarget(data.renderer);
+    SDL_RenderGetViewport(data.renderer, &data.layers.former_viewport);
+    SDL_RenderGetClipRect(data.renderer, &data.layers.former_clip);
+    if (SDL_SetRenderTarget(data.renderer, layer->texture) != 0) {
+        return 0;
+    }
+    data.layers.is_creating = 1;
+    SDL_RenderSetClipRect(data.renderer, NULL);
+    SDL_SetRenderDrawColor(data.renderer, 0, 0, 0, 0);
+    SDL_RenderClear(data.renderer);
+    return layer->id;
+}
+
+static void finish_layer_creation(void)
+{
+    if (!data.layers.is_creating) {
+        return;
+    }
+    flush_batch();
+    data.layers.is_creating = 0;
+    SDL_SetRenderTarget(data.renderer, data.layers.former_target);
+    SDL_RenderSetViewport(data.renderer, &data.layers.former_viewport);
+    SDL_RenderSetClipRect(data.renderer,
+        SDL_RectEmpty(&data.layers.former_clip) ? NULL : &data.layers.former_clip);
+}
+
+static int draw_layer(int layer_id, int x, int y, float scale)
+{
+    if (data.paused) {
+        return 0;
+    }
+    buffer_texture *layer = find_buffer_texture(data.layers.first, layer_id);
+    if (!layer || !layer->texture) {
+        return 0;
+    }
+    flush_batch();
+    SDL_Rect src_coords = { 0, 0, layer->width, layer->height };
+#ifdef USE_RENDERCOPYF
+    if (HAS_RENDERCOPYF) {
+        SDL_FRect dst_coords = { x / scale, y / scale, (float) layer->width, (float) layer->height };
+        SDL_RenderCopyF(data.renderer, layer->texture, &src_coords, &dst_coords);
+        return 1;
+    }
+#endif
+    SDL_Rect dst_coords = { (int) round(x / scale), (int) round(y / scale), layer->width, layer->height };
+    SDL_RenderCopy(data.renderer, layer->texture, &src_coords, &dst_coords);
+    return 1;
+}
+
+static void free_layer(int layer_id)
+{
+    buffer_texture *previous = 0;
+    for (buffer_texture *layer = data.layers.first; layer; previous = layer, layer = layer->next) {
+        if (layer->id != layer_id) {
+            continue;
+        }
+        if (previous) {
+            previous->next = layer->next;
+        } else {
+            data.layers.first = layer->next;
+        }
+        if (data.layers.last == layer) {
+            data.layers.last = previous;
+        }
+        if (layer->texture) {
+            SDL_DestroyTexture(layer->texture);
+        }
+        free(layer);
+        return;
+    }
+}
+
 static void create_blend_texture(custom_image_type type)
 {
+    flush_batch();
     SDL_Texture *texture = SDL_CreateTexture(data.renderer, SDL_PIXELFORMAT_ABGR8888, SDL_TEXTUREACCESS_TARGET, 58, 30);
     if (!texture) {
         return;
@@ -990,6 +1316,7 @@ static SDL_Texture *get_silhouette_texture(const image *img)
 
 static void draw_silhouetted_texture(const image *img, int x, int y, color_t color, float scale)
 {
+    flush_batch();
     SDL_Texture *texture = get_silhouette_texture(img);
     if (!texture) {
         return;
@@ -1172,6 +1499,10 @@ static void create_renderer_interface(void)
     data.renderer_interface.save_image_from_screen = save_to_texture;
     data.renderer_interface.draw_image_to_screen = draw_saved_texture;
     data.renderer_interface.save_screen_buffer = save_screen_buffer;
+    data.renderer_interface.start_layer_creation = start_layer_creation;
+    data.renderer_interface.finish_layer_creation = finish_layer_creation;
+    data.renderer_interface.draw_layer = draw_layer;
+    data.renderer_interface.free_layer = free_layer;
     data.renderer_interface.get_max_image_size = get_max_image_size;
     data.renderer_interface.prepare_image_atlas = prepare_texture_atlas;
     data.renderer_interface.create_image_atlas = create_texture_atlas;
@@ -1244,6 +1575,7 @@ int platform_renderer_init(SDL_Window *window)
 
     SDL_SetRenderDrawColor(data.renderer, 0, 0, 0, 0xff);
 
+    init_batch();
     create_renderer_interface();
 
     return 1;
@@ -1266,6 +1598,7 @@ int platform_renderer_create_render_texture(int width, int height)
     if (data.paused) {
         return 1;
     }
+    flush_batch();
     destroy_render_texture();
 
 #ifdef USE_TEXTURE_SCALE_MODE
@@ -1337,6 +1670,14 @@ void platform_renderer_invalidate_target_textures(void)
         SDL_DestroyTexture(data.tooltip.texture);
         data.tooltip.texture = 0;
     }
+    free_layers();
+}
+
+void platform_renderer_free_layers(void)
+{
+    if (!data.layers.is_creating) {
+        free_layers();
+    }
 }
 
 void platform_renderer_clear(void)
@@ -1392,6 +1733,7 @@ void platform_renderer_render(void)
     if (data.paused) {
         return;
     }
+    flush_batch();
     SDL_SetRenderTarget(data.renderer, NULL);
     SDL_RenderCopy(data.renderer, data.render_texture, NULL, NULL);
     draw_tooltip();
@@ -1427,6 +1769,7 @@ void platform_renderer_generate_mouse_cursor_texture(int cursor_id, int size, co
 
 void platform_renderer_pause(void)
 {
+    flush_batch();
     SDL_SetRenderTarget(data.renderer, NULL);
     data.paused = 1;
 }
@@ -1440,6 +1783,7 @@ void platform_renderer_resume(void)
 
 void platform_renderer_destroy(void)
 {
+    flush_batch();
     destroy_render_texture();
     if (data.renderer) {
         SDL_DestroyRenderer(data.renderer);
@@ -13,6 +13,8 @@ int platform_renderer_lost_render_texture(void);
 
 void platform_renderer_invalidate_target_textures(void);
 
+void platform_renderer_free_layers(void);
+
 void platform_renderer_generate_mouse_cursor_texture(int cursor_id, int size, const color_t *pixels,
     int hotspot_x, int hotspot_y);
 
@@ -0,0 +1,67 @@
+#include "platform/thread.h"
+
+#include "core/log.h"
+
+#include "SDL.h"
+
+platform_thread *platform_thread_create(int (*function)(void *), const char *name, void *data)
+{
+    SDL_Thread *thread = SDL_CreateThread(function, name, data);
+    if (!thread) {
+        log_error("Unable to create thread", SDL_GetError(), 0);
+    }
+    return (platform_thread *) thread;
+}
+
+int platform_thread_wait(platform_thread *thread)
+{
+    int result = 0;
+    SDL_WaitThread((SDL_Thread *) thread, &result);
+    return result;
+}
+
+int platform_thread_cpu_count(void)
+{
+    int count = SDL_GetCPUCount();
+    return count > 0 ? count : 1;
+}
+
+platform_mutex *platform_mutex_create(void)
+{
+    return (platform_mutex *) SDL_CreateMutex();
+}
+
+void platform_mutex_lock(platform_mutex *mutex)
+{
+    SDL_LockMutex((SDL_mutex *) mutex);
+}
+
+void platform_mutex_unlock(platform_mutex *mutex)
+{
+    SDL_UnlockMutex((SDL_mutex *) mutex);
+}
+
+void platform_mutex_destroy(platform_mutex *mutex)
+{
+    SDL_DestroyMutex((SDL_mutex *) mutex);
+}
+
+platform_semaphore *platform_semaphore_create(int initial_value)
+{
+    return (platform_semaphore *) SDL_CreateSemaphore(initial_value);
+}
+
+void platform_semaphore_wait(platform_semaphore *semaphore)
+{
+    SDL_SemWait((SDL_sem *) semaphore);
+}
+
+void platform_semaphore_post(platform_semaphore *semaphore)
+{
+    SDL_SemPost((SDL_sem *) semaphore);
+}
+
+void platform_semaphore_destroy(platform_semaphore *semaphore)
+{
+    SDL_DestroySemaphore((SDL_sem *) semaphore);
+}
@@ -0,0 +1,84 @@
+#ifndef PLATFORM_THREAD_H
+#define PLATFORM_THREAD_H
+
+/**
+ * @file
+ * Thin wrappers around the threading primitives of the underlying system
+ */
+
+typedef struct platform_thread platform_thread;
+typedef struct platform_mutex platform_mutex;
+typedef struct platform_semaphore platform_semaphore;
+
+/**
+ * Starts a new thread
+ * @param function The function to run on the thread, its return value is passed to platform_thread_wait
+ * @param name Name of the thread, for debugging purposes
+ * @param data Data to pass to the function
+ * @return The thread, or 0 if threads are not available, in which case the caller should do the work itself
+ */
+platform_thread *platform_thread_create(int (*function)(void *), const char *name, void *data);
+
+/**
+ * Waits for a thread to finish and releases it
+ * @param thread The thread to wait for
+ * @return The return value of the thread function
+ */
+int platform_thread_wait(platform_thread *thread);
+
+/**
+ * Gets the number of logical CPU cores
+ * @return The number of cores, at least 1
+ */
+int platform_thread_cpu_count(void);
+
+/**
+ * Creates a mutex
+ * @return The mutex, or 0 on failure
+ */
+platform_mutex *platform_mutex_create(void);
+
+/**
+ * Locks a mutex, blocking until it is available
+ * @param mutex The mutex to lock
+ */
+void platform_mutex_lock(platform_mutex *mutex);
+
+/**
+ * Unlocks a mutex
+ * @param mutex The mutex to unlock
+ */
+void platform_mutex_unlock(platform_mutex *mutex);
+
+/**
+ * Destroys a mutex
+ * @param mutex The mutex to destroy
+ */
+void platform_mutex_destroy(platform_mutex *mutex);
+
+/**
+ * Creates a semaphore
+ * @param initial_value The initial value of the semaphore
+ * @return The semaphore, or 0 on failure
+ */
+platform_semaphore *platform_semaphore_create(int initial_value);
+
+/**
+ * Waits until the value of a semaphore is above zero and decrements it
+ * @param semaphore The semaphore to wait for
+ */
+void platform_semaphore_wait(platform_semaphore *semaphore);
+
+/**
+ * Increments the value of a semaphore, waking up a thread waiting for it
+ * @param semaphore The semaphore to increment
+ */
+void platform_semaphore_post(platform_semaphore *semaphore);
+
+/**
+ * Destroys a semaphore
+ * @param semaphore The semaphore to destroy
+ */
+void platform_semaphore_destroy(platform_semaphore *semaphore);
+
+#endif // PLATFORM_THREAD_H
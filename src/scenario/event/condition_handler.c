@@ -94,6 +94,20 @@ int scenario_condition_type_is_met(scenario_condition_t *condition)
     }
 }
 
+int scenario_condition_type_is_expensive(const scenario_condition_t *condition)
+{
+    // These walk the buildings, the other conditions read values the city already keeps
+    switch (condition->type) {
+        case CONDITION_TYPE_BUILDING_COUNT_ACTIVE:
+        case CONDITION_TYPE_BUILDING_COUNT_ANY:
+        case CONDITION_TYPE_BUILDING_COUNT_AREA:
+        case CONDITION_TYPE_RESOURCE_STORAGE_AVAILABLE:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
 void scenario_condition_type_delete(scenario_condition_t *condition)
 {
     memset(condition, 0, sizeof(scenario_condition_t));
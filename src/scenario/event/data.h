@@ -151,6 +151,9 @@ typedef struct {
     uint8_t name[EVENT_NAME_LENGTH];
     array(scenario_condition_group_t) condition_groups;
     array(scenario_action_t) actions;
+    // Not saved: the group and condition that were not met on the last check, plus one
+    unsigned int unmet_group;
+    unsigned int unmet_condition;
 } scenario_event_t;
 
 #endif // SCENARIO_EVENT_DATA_H
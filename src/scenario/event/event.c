@@ -156,6 +156,40 @@ int scenario_event_can_repeat(scenario_event_t *event)
         ((event->execution_count < event->max_number_of_repeats) || (event->max_number_of_repeats <= 0));
 }
 
+static int condition_group_is_met(scenario_event_t *event, unsigned int group_index)
+{
+    scenario_condition_group_t *group = array_item(event->condition_groups, group_index);
+    unsigned int checked_condition = group->conditions.size;
+
+    // A condition that was not met last time is likely to still not be met, so check it first
+    if (group->type == FULFILLMENT_TYPE_ALL && event->unmet_group == group_index + 1 &&
+        event->unmet_condition > 0 && event->unmet_condition <= group->conditions.size) {
+        checked_condition = event->unmet_condition - 1;
+        if (!scenario_condition_type_is_met(array_item(group->conditions, checked_condition))) {
+            return 0;
+        }
+    }
+
+    // Conditions only read the current state, so the cheap ones can be checked before those that walk buildings
+    for (int expensive = 0; expensive <= 1; expensive++) {
+        for (unsigned int i = 0; i < group->conditions.size; i++) {
+            scenario_condition_t *condition = array_item(group->conditions, i);
+            if (i == checked_condition || scenario_condition_type_is_expensive(condition) != expensive) {
+                continue;
+            }
+            int is_met = scenario_condition_type_is_met(condition);
+            if (group->type == FULFILLMENT_TYPE_ALL && !is_met) {
+                event->unmet_condition = i + 1;
+                return 0;
+            }
+            if (group->type == FULFILLMENT_TYPE_ANY && is_met) {
+                return 1;
+            }
+        }
+    }
+    return group->type != FULFILLMENT_TYPE_ANY || group->conditions.size == 0;
+}
+
 static int conditions_fulfilled(scenario_event_t *event)
 {
     if (event->state != EVENT_STATE_ACTIVE) {
@@ -164,24 +198,22 @@ static int conditions_fulfilled(scenario_event_t *event)
     if (event->actions.size == 0) {
         return 0;
     }
-    
-    scenario_condition_group_t *group;
-    array_foreach(event->condition_groups, group) {
-        int group_fulfilled = 0;
-        for (unsigned int i = 0; i < group->conditions.size; i++) {
-            scenario_condition_t *condition = array_item(group->conditions, i);
-            if (group->type == FULFILLMENT_TYPE_ALL && !scenario_condition_type_is_met(condition)) {
-                return 0;
-            }
-            if (group->type == FULFILLMENT_TYPE_ANY && scenario_condition_type_is_met(condition)) {
-                group_fulfilled = 1;
-                break;
-            }
+
+    unsigned int checked_group = event->condition_groups.size;
+    if (event->unmet_group > 0 && event->unmet_group <= event->condition_groups.size) {
+        checked_group = event->unmet_group - 1;
+        if (!condition_group_is_met(event, checked_group)) {
+            return 0;
         }
-        if (group->type == FULFILLMENT_TYPE_ANY && group->conditions.size > 0 && !group_fulfilled) {
+    }
+    for (unsigned int i = 0; i < event->condition_groups.size; i++) {
+        if (i != checked_group && !condition_group_is_met(event, i)) {
+            event->unmet_group = i + 1;
             return 0;
         }
     }
+    event->unmet_group = 0;
+    event->unmet_condition = 0;
 
     return 1;
 }
@@ -1424,6 +1424,8 @@ static translation_string all_strings[] = {
     {TR_BUILDING_PANELLED_GARDEN_WALL_GATE, "Paneled garden wall gate" },
     {TR_BUILDING_PANELLED_GARDEN_WALL_GATE_DESC, "This small gate controls the movement of people in and out of your city's most secluded spots." },
     {TR_HOTKEY_BUILD_HIGHWAY, "Highway" },
+    {TR_HOTKEY_TOGGLE_TICK_PROFILER, "Toggle tick profiler" },
+    {TR_HOTKEY_SAVE_TICK_PROFILE, "Save tick profile" },
     {TR_BUILDING_SHRINE_DESC, "This altar provides a place for your citizens to make sacrifices and prayers to their chosen deity."},
     {TR_BUILDING_SHRINE_CERES, "Altar of Ceres"},
     {TR_BUILDING_SHRINE_MARS, "Altar of Mars"},
@@ -1423,6 +1423,8 @@ typedef enum {
     TR_BUILDING_PANELLED_GARDEN_WALL_GATE,
     TR_BUILDING_PANELLED_GARDEN_WALL_GATE_DESC,
     TR_HOTKEY_BUILD_HIGHWAY,
+    TR_HOTKEY_TOGGLE_TICK_PROFILER,
+    TR_HOTKEY_SAVE_TICK_PROFILE,
     TR_BUILDING_SHRINE_DESC,
     TR_BUILDING_SHRINE_CERES,
     TR_BUILDING_SHRINE_MARS,
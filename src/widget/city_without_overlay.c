@@ -31,6 +31,7 @@
 #include "graphics/graphics.h"
 #include "graphics/image.h"
 #include "graphics/renderer.h"
+#include "graphics/screen.h"
 #include "graphics/window.h"
 #include "map/building.h"
 #include "map/figure.h"
@@ -46,10 +47,27 @@
 #include "widget/city_figure.h"
 #include "widget/city_draw_highway.h"
 
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+
 #define OFFSET(x,y) (x + GRID_SIZE * y)
 
 #define WAREHOUSE_FLAG_FRAMES 9
 
+#define CACHE_CHUNK_WIDTH 16
+#define CACHE_CHUNK_HEIGHT 32
+#define CACHE_CHUNKS_X ((VIEW_X_MAX + CACHE_CHUNK_WIDTH - 1) / CACHE_CHUNK_WIDTH)
+#define CACHE_CHUNKS_Y ((VIEW_Y_MAX + CACHE_CHUNK_HEIGHT - 1) / CACHE_CHUNK_HEIGHT)
+#define MAX_CACHED_CHUNKS 128
+// Layers may use as many pixels as this many screens, the chunks on screen need about two of them
+#define CACHE_SCREENS_OF_PIXELS 3
+#define CACHE_CHUNK_IDLE_MILLIS 10000
+
+#define SIGNATURE_EMPTY 0
+#define SIGNATURE_DYNAMIC 0x80000000
+#define SIGNATURE_GRID 0x40000000
+
 static const int ADJACENT_OFFSETS[2][4][7] = {
     {
         {OFFSET(-1, 0), OFFSET(-1, -1),  OFFSET(-1, -2), OFFSET(0, -2), OFFSET(1, -2)},
@@ -78,6 +96,41 @@ static struct {
     float scale;
 } draw_context;
 
+typedef struct {
+    int in_use;
+    int is_drawn;
+    int is_empty;
+    int x;
+    int y;
+    int layer_id;
+    int scale;
+    int x_offset;
+    int y_offset;
+    int layer_pixels;
+    unsigned int last_used;
+    time_millis last_used_time;
+    unsigned int signatures[CACHE_CHUNK_WIDTH * CACHE_CHUNK_HEIGHT];
+} cached_chunk;
+
+// Footprints of N x N view tile blocks, drawn once to a layer and only drawn again when one of their tiles changes
+static struct {
+    int is_active;
+    unsigned int frame;
+    float scale;
+    int layer_pixels;
+    cached_chunk chunks[MAX_CACHED_CHUNKS];
+    int chunk_slots[CACHE_CHUNKS_X][CACHE_CHUNKS_Y];
+    unsigned int tile_cached_frame[GRID_SIZE * GRID_SIZE];
+    cached_chunk *current;
+    int has_changed;
+    struct {
+        int x_min;
+        int y_min;
+        int x_max;
+        int y_max;
+    } bounds;
+} footprint_cache;
+
 static void init_draw_context(int selected_figure_id, pixel_coordinate *figure_coord, int highlighted_formation)
 {
     draw_context.advance_water_animation = 0;
@@ -140,6 +193,309 @@ static void draw_roamer_frequency(int x, int y, int grid_offset)
     }
 }
 
+static int get_grid_image_id(void)
+{
+    static int grid_id = 0;
+    if (!grid_id) {
+        grid_id = assets_get_image_id("UI", "Grid_Full");
+    }
+    return grid_id;
+}
+
+static int shows_grid(int building_id)
+{
+    return !building_id && config_get(CONFIG_UI_SHOW_GRID) && draw_context.scale <= 2.0f;
+}
+
+static int is_highway_footprint(int grid_offset)
+{
+    return map_terrain_is(grid_offset, TERRAIN_HIGHWAY) && !map_terrain_is(grid_offset, TERRAIN_GATEHOUSE);
+}
+
+static int footprint_is_dynamic(int grid_offset, int image_id, color_t color_mask)
+{
+    return color_mask || map_property_is_constructing(grid_offset) || is_highway_footprint(grid_offset) ||
+        (image_id >= draw_context.image_id_water_first && image_id <= draw_context.image_id_water_last);
+}
+
+static unsigned int get_footprint_signature(int grid_offset)
+{
+    if (grid_offset < 0 || !map_property_is_draw_tile(grid_offset)) {
+        return SIGNATURE_EMPTY;
+    }
+    int building_id = map_building_at(grid_offset);
+    color_t color_mask = building_id && draw_building_as_deleted(building_get(building_id)) ? COLOR_MASK_RED : 0;
+    int image_id = map_image_at(grid_offset);
+    if (footprint_is_dynamic(grid_offset, image_id, color_mask)) {
+        return SIGNATURE_DYNAMIC;
+    }
+    return (image_id + 1) | (shows_grid(building_id) ? SIGNATURE_GRID : 0);
+}
+
+static int is_cached_signature(unsigned int signature)
+{
+    return signature != SIGNATURE_EMPTY && signature != SIGNATURE_DYNAMIC;
+}
+
+static void foreach_chunk_tile(const cached_chunk *chunk, void (*callback)(int index, int x, int y, int grid_offset))
+{
+    int x_view_start = chunk->x * CACHE_CHUNK_WIDTH;
+    int y_view_start = chunk->y * CACHE_CHUNK_HEIGHT;
+    int x_origin, y_origin;
+    city_view_get_view_tile_pixel_position(x_view_start, y_view_start, &x_origin, &y_origin);
+    int index = 0;
+    for (int y_view = y_view_start; y_view < y_view_start + CACHE_CHUNK_HEIGHT; y_view++) {
+        for (int x_view = x_view_start; x_view < x_view_start + CACHE_CHUNK_WIDTH; x_view++) {
+            int x, y;
+            city_view_get_view_tile_pixel_position(x_view, y_view, &x, &y);
+            callback(index++, x - x_origin, y - y_origin, city_view_get_grid_offset_at_view_tile(x_view, y_view));
+        }
+    }
+}
+
+static void update_tile_signature(int index, int x, int y, int grid_offset)
+{
+    unsigned int signature = get_footprint_signature(grid_offset);
+    if (footprint_cache.current->signatures[index] != signature) {
+        footprint_cache.current->signatures[index] = signature;
+        footprint_cache.has_changed = 1;
+    }
+}
+
+static void include_in_bounds(int x, int y, int width, int height)
+{
+    if (x < footprint_cache.bounds.x_min) {
+        footprint_cache.bounds.x_min = x;
+    }
+    if (y < footprint_cache.bounds.y_min) {
+        footprint_cache.bounds.y_min = y;
+    }
+    if (x + width > footprint_cache.bounds.x_max) {
+        footprint_cache.bounds.x_max = x + width;
+    }
+    if (y + height > footprint_cache.bounds.y_max) {
+        footprint_cache.bounds.y_max = y + height;
+    }
+}
+
+static void include_tile_in_bounds(int index, int x, int y, int grid_offset)
+{
+    unsigned int signature = footprint_cache.current->signatures[index];
+    if (!is_cached_signature(signature)) {
+        return;
+    }
+    const image *img = image_get(map_image_at(grid_offset));
+    int num_tiles = (img->width + 2) / (FOOTPRINT_WIDTH + 2);
+    include_in_bounds(x + img->x_offset, y - FOOTPRINT_HALF_HEIGHT * (num_tiles - 1) + img->y_offset,
+        img->width, img->height);
+    if (signature & SIGNATURE_GRID) {
+        const image *grid = image_get(get_grid_image_id());
+        include_in_bounds(x + grid->x_offset, y + grid->y_offset, grid->width, grid->height);
+    }
+}
+
+static void draw_cached_tile(int index, int x, int y, int grid_offset)
+{
+    unsigned int signature = footprint_cache.current->signatures[index];
+    if (!is_cached_signature(signature)) {
+        return;
+    }
+    x -= footprint_cache.bounds.x_min;
+    y -= footprint_cache.bounds.y_min;
+    image_draw_isometric_footprint_from_draw_tile(map_image_at(grid_offset), x, y, 0, draw_context.scale);
+    if (signature & SIGNATURE_GRID) {
+        image_draw(get_grid_image_id(), x, y, COLOR_GRID, draw_context.scale);
+    }
+}
+
+static void mark_tile_as_cached(int index, int x, int y, int grid_offset)
+{
+    if (is_cached_signature(footprint_cache.current->signatures[index])) {
+        footprint_cache.tile_cached_frame[grid_offset] = footprint_cache.frame;
+    }
+}
+
+static void release_chunk(cached_chunk *chunk)
+{
+    if (chunk->layer_id) {
+        graphics_renderer()->free_layer(chunk->layer_id);
+    }
+    footprint_cache.layer_pixels -= chunk->layer_pixels;
+    footprint_cache.chunk_slots[chunk->x][chunk->y] = 0;
+    memset(chunk, 0, sizeof(cached_chunk));
+}
+
+static void release_all_chunks(void)
+{
+    for (int i = 0; i < MAX_CACHED_CHUNKS; i++) {
+        if (footprint_cache.chunks[i].in_use) {
+            release_chunk(&footprint_cache.chunks[i]);
+        }
+    }
+}
+
+static void release_idle_chunks(void)
+{
+    time_millis now = time_get_millis();
+    for (int i = 0; i < MAX_CACHED_CHUNKS; i++) {
+        cached_chunk *chunk = &footprint_cache.chunks[i];
+        if (chunk->in_use && now - chunk->last_used_time > CACHE_CHUNK_IDLE_MILLIS) {
+            release_chunk(chunk);
+        }
+    }
+}
+
+static cached_chunk *get_least_recently_used_chunk(void)
+{
+    // Never one that is already on screen this frame
+    cached_chunk *result = 0;
+    for (int i = 0; i < MAX_CACHED_CHUNKS; i++) {
+        cached_chunk *chunk = &footprint_cache.chunks[i];
+        if (chunk->in_use && chunk->last_used != footprint_cache.frame &&
+            (!result || chunk->last_used < result->last_used)) {
+            result = chunk;
+        }
+    }
+    return result;
+}
+
+static int make_room_for_pixels(int pixels)
+{
+    int budget = CACHE_SCREENS_OF_PIXELS * screen_width() * screen_height();
+    while (footprint_cache.layer_pixels + pixels > budget) {
+        cached_chunk *chunk = get_least_recently_used_chunk();
+        if (!chunk) {
+            return 0;
+        }
+        release_chunk(chunk);
+    }
+    return 1;
+}
+
+static cached_chunk *get_cached_chunk(int chunk_x, int chunk_y)
+{
+    int slot = footprint_cache.chunk_slots[chunk_x][chunk_y] - 1;
+    if (slot >= 0) {
+        return &footprint_cache.chunks[slot];
+    }
+    cached_chunk *chunk = 0;
+    for (int i = 0; i < MAX_CACHED_CHUNKS && !chunk; i++) {
+        if (!footprint_cache.chunks[i].in_use) {
+            chunk = &footprint_cache.chunks[i];
+        }
+    }
+    if (!chunk) {
+        chunk = get_least_recently_used_chunk();
+        if (!chunk) {
+            return 0;
+        }
+        release_chunk(chunk);
+    }
+    chunk->in_use = 1;
+    chunk->x = chunk_x;
+    chunk->y = chunk_y;
+    footprint_cache.chunk_slots[chunk_x][chunk_y] = (int) (chunk - footprint_cache.chunks) + 1;
+    return chunk;
+}
+
+static int draw_chunk_to_layer(cached_chunk *chunk)
+{
+    footprint_cache.bounds.x_min = footprint_cache.bounds.y_min = INT_MAX;
+    footprint_cache.bounds.x_max = footprint_cache.bounds.y_max = INT_MIN;
+    foreach_chunk_tile(chunk, include_tile_in_bounds);
+    chunk->scale = city_view_get_scale();
+    chunk->is_empty = footprint_cache.bounds.x_min == INT_MAX;
+    if (chunk->is_empty) {
+        return 1;
+    }
+    // Leave room for the texture offset corrections of the renderer
+    footprint_cache.bounds.x_min -= 2;
+    footprint_cache.bounds.y_min -= 2;
+    footprint_cache.bounds.x_max += 2;
+    footprint_cache.bounds.y_max += 2;
+    int width = (int) ceil((footprint_cache.bounds.x_max - footprint_cache.bounds.x_min) / draw_context.scale);
+    int height = (int) ceil((footprint_cache.bounds.y_max - footprint_cache.bounds.y_min) / draw_context.scale);
+    // The renderer only ever grows the texture of a layer
+    int extra_pixels = width * height - chunk->layer_pixels;
+    if (extra_pixels > 0 && !make_room_for_pixels(extra_pixels)) {
+        return 0;
+    }
+    int layer_id = graphics_renderer()->start_layer_creation(chunk->layer_id, width, height);
+    if (!layer_id) {
+        return 0;
+    }
+    chunk->layer_id = layer_id;
+    if (extra_pixels > 0) {
+        chunk->layer_pixels += extra_pixels;
+        footprint_cache.layer_pixels += extra_pixels;
+    }
+    foreach_chunk_tile(chunk, draw_cached_tile);
+    graphics_renderer()->finish_layer_creation();
+    chunk->x_offset = footprint_cache.bounds.x_min;
+    chunk->y_offset = footprint_cache.bounds.y_min;
+    return 1;
+}
+
+static int draw_cached_chunk(int chunk_x, int chunk_y)
+{
+    cached_chunk *chunk = get_cached_chunk(chunk_x, chunk_y);
+    if (!chunk) {
+        return 0;
+    }
+    chunk->last_used = footprint_cache.frame;
+    chunk->last_used_time = time_get_millis();
+    footprint_cache.current = chunk;
+    footprint_cache.has_changed = 0;
+    foreach_chunk_tile(chunk, update_tile_signature);
+    if (footprint_cache.has_changed || !chunk->is_drawn || chunk->scale != city_view_get_scale()) {
+        chunk->is_drawn = draw_chunk_to_layer(chunk);
+        if (!chunk->is_drawn) {
+            return 0;
+        }
+    }
+    if (chunk->is_empty) {
+        return 1;
+    }
+    int x, y;
+    city_view_get_view_tile_pixel_position(chunk_x * CACHE_CHUNK_WIDTH, chunk_y * CACHE_CHUNK_HEIGHT, &x, &y);
+    if (!graphics_renderer()->draw_layer(chunk->layer_id, x + chunk->x_offset, y + chunk->y_offset,
+        draw_context.scale)) {
+        // The renderer drops the layers when the images are reloaded or the window is minimized
+        release_chunk(chunk);
+        return 0;
+    }
+    foreach_chunk_tile(chunk, mark_tile_as_cached);
+    return 1;
+}
+
+static void draw_cached_footprints(void)
+{
+    if (footprint_cache.scale != draw_context.scale) {
+        // Every layer would have to be drawn again anyway
+        release_all_chunks();
+        footprint_cache.scale = draw_context.scale;
+    }
+    // Zoomed in, there are few tiles to draw and the layers would take a lot of memory
+    footprint_cache.is_active = draw_context.scale >= 1.0f;
+    if (!footprint_cache.is_active) {
+        return;
+    }
+    release_idle_chunks();
+    footprint_cache.frame++;
+    view_tile first, last;
+    city_view_get_valid_view_tile_range(&first, &last);
+    for (int y = first.y / CACHE_CHUNK_HEIGHT; y <= last.y / CACHE_CHUNK_HEIGHT; y++) {
+        for (int x = first.x / CACHE_CHUNK_WIDTH; x <= last.x / CACHE_CHUNK_WIDTH; x++) {
+            draw_cached_chunk(x, y);
+        }
+    }
+}
+
+static int footprint_is_cached(int grid_offset)
+{
+    return footprint_cache.is_active && footprint_cache.tile_cached_frame[grid_offset] == footprint_cache.frame;
+}
+
 static void draw_footprint(int x, int y, int grid_offset)
 {
     sound_city_progress_ambient();
@@ -191,17 +547,15 @@ static void draw_footprint(int x, int y, int grid_offset)
         }
         map_image_set(grid_offset, image_id);
     }
-    if (map_terrain_is(grid_offset, TERRAIN_HIGHWAY) && !map_terrain_is(grid_offset, TERRAIN_GATEHOUSE)) {
-        city_draw_highway_footprint(x, y, draw_context.scale, grid_offset);
-    } else {
-        image_draw_isometric_footprint_from_draw_tile(image_id, x, y, color_mask, draw_context.scale);
-    }
-    if (!building_id && config_get(CONFIG_UI_SHOW_GRID) && draw_context.scale <= 2.0f) {
-        static int grid_id = 0;
-        if (!grid_id) {
-            grid_id = assets_get_image_id("UI", "Grid_Full");
+    if (!footprint_is_cached(grid_offset)) {
+        if (is_highway_footprint(grid_offset)) {
+            city_draw_highway_footprint(x, y, draw_context.scale, grid_offset);
+        } else {
+            image_draw_isometric_footprint_from_draw_tile(image_id, x, y, color_mask, draw_context.scale);
+        }
+        if (shows_grid(building_id)) {
+            image_draw(get_grid_image_id(), x, y, COLOR_GRID, draw_context.scale);
         }
-        image_draw(grid_id, x, y, COLOR_GRID, draw_context.scale);
     }
     draw_roamer_frequency(x, y, grid_offset);
 }
@@ -961,6 +1315,7 @@ void city_without_overlay_draw(int selected_figure_id, pixel_coordinate *figure_
     city_view_get_viewport(&x, &y, &width, &height);
     graphics_fill_rect(x, y, width, height, COLOR_BLACK);
     int should_mark_deleting = city_building_ghost_mark_deleting(tile);
+    draw_cached_footprints();
     city_view_foreach_valid_map_tile(draw_footprint);
     if (!should_mark_deleting) {
         city_view_foreach_valid_map_tile_row(
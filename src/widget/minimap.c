@@ -20,6 +20,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#define DIRTY_BAND_HEIGHT 8
+
 enum {
     FIGURE_COLOR_NONE = 0,
     FIGURE_COLOR_SOLDIER = 1,
@@ -48,6 +50,25 @@ typedef struct {
     tile_color edges;
     tile_color center;
 } building_tile_color;
+
+typedef enum {
+    TILE_APPEARANCE_NONE = 0,
+    TILE_APPEARANCE_FIGURE = 1,
+    TILE_APPEARANCE_TERRAIN = 2,
+    TILE_APPEARANCE_BUILDING = 3
+} tile_appearance_type;
+
+typedef struct {
+    int grid_offset;
+    tile_appearance_type type;
+    int size;
+    const void *colors; // color_t for figures, tile_color for terrain, building_tile_color for buildings
+} tile_appearance;
+
+typedef struct {
+    int x_min;
+    int x_max;
+} dirty_band;
 static void get_viewport(int *x, int *y, int *width, int *height);
 
 static minimap_functions default_functions = {
@@ -162,7 +183,15 @@ static struct {
     } minimap;
     struct {
         int stride;
+        int height;
         color_t *buffer;
+        color_t *upload_buffer;
+        tile_appearance *tiles;
+        int max_tiles;
+        int num_tiles;
+        int is_valid;
+        dirty_band *bands;
+        int num_bands;
     } cache;
     const minimap_functions *functions;
     struct {
@@ -286,7 +315,13 @@ static int has_figure_color(figure *f)
 
 static inline void draw_pixel(int x, int y, color_t color)
 {
-    data.cache.buffer[y * data.cache.stride + x] = color;
+    if (y < 0 || y >= data.cache.height) {
+        return;
+    }
+    const dirty_band *band = &data.cache.bands[y / DIRTY_BAND_HEIGHT];
+    if (x >= band->x_min && x <= band->x_max) {
+        data.cache.buffer[y * data.cache.stride + x] = color;
+    }
 }
 
 static inline void draw_tile(int x_offset, int y_offset, const tile_color *colors)
@@ -295,7 +330,7 @@ static inline void draw_tile(int x_offset, int y_offset, const tile_color *color
     draw_pixel(x_offset + 1, y_offset, colors->right);
 }
 
-static int draw_figure(int x_view, int y_view, int grid_offset)
+static int get_figure_appearance(int grid_offset, tile_appearance *tile)
 {
     if (!data.functions->offset.figure) {
         return 0;
@@ -304,16 +339,16 @@ static int draw_figure(int x_view, int y_view, int grid_offset)
     if (color_type == FIGURE_COLOR_NONE) {
         return 0;
     }
-    color_t color = minimap_colors.wolf;
+    const color_t *color = &minimap_colors.wolf;
     if (color_type == FIGURE_COLOR_SOLDIER) {
-        color = minimap_colors.soldier;
+        color = &minimap_colors.soldier;
     } else if (color_type == FIGURE_COLOR_SELECTED_SOLDIER) {
-        color = minimap_colors.selected_soldier;
+        color = &minimap_colors.selected_soldier;
     } else if (color_type == FIGURE_COLOR_ENEMY) {
-        color = minimap_colors.climate->enemy;
+        color = &minimap_colors.climate->enemy;
     }
-    draw_pixel(x_view, y_view, color);
-    draw_pixel(x_view + 1, y_view, color);
+    tile->type = TILE_APPEARANCE_FIGURE;
+    tile->colors = color;
     return 1;
 }
 
@@ -342,21 +377,21 @@ static int building_is_water_structure(building_type type)
     return type == BUILDING_RESERVOIR || type == BUILDING_FOUNTAIN || type == BUILDING_WELL;
 }
 
-static void draw_building(int x_offset, int y_offset, int grid_offset)
+static void get_building_appearance(int grid_offset, tile_appearance *tile)
 {
     if (!data.functions->offset.is_draw_tile(grid_offset)) {
         return;
     }
 
     const building_tile_color *colors = &minimap_colors.building;
-    int size = data.functions->offset.tile_size(grid_offset);
 
     if (data.functions->building) {
         building *b = data.functions->building(data.functions->offset.building_id(grid_offset));
 
         // Palisades are drawn like walls
         if (b->type == BUILDING_PALISADE) {
-            draw_tile(x_offset, y_offset, &minimap_colors.wall);
+            tile->type = TILE_APPEARANCE_TERRAIN;
+            tile->colors = &minimap_colors.wall;
             return;
         }
 
@@ -376,6 +411,13 @@ static void draw_building(int x_offset, int y_offset, int grid_offset)
             colors = &minimap_colors.aesthetics;
         } 
     }
+    tile->type = TILE_APPEARANCE_BUILDING;
+    tile->size = data.functions->offset.tile_size(grid_offset);
+    tile->colors = colors;
+}
+
+static void draw_building(int x_offset, int y_offset, const building_tile_color *colors, int size)
+{
     if (size == 1) {
         // The 1x1 house image is inverted for some reason
         if (colors == &minimap_colors.house) {
@@ -400,9 +442,9 @@ static void draw_building(int x_offset, int y_offset, int grid_offset)
         if (x_start + x_offset < 0) {
             x_start = -x_offset - 1;
         }
-        color_t *value = &data.cache.buffer[(y_offset + y) * data.cache.stride + x_start + x_offset + 1];
         for (int x = x_start; x < x_end - 1; x++) {
-            *value++ = ((size + x + y) & 1) ? colors->center.left : colors->center.right;
+            draw_pixel(x + x_offset + 1, y + y_offset,
+                ((size + x + y) & 1) ? colors->center.left : colors->center.right);
         }
     }
     y_offset += height / 2 + 1;
@@ -417,26 +459,30 @@ static void draw_building(int x_offset, int y_offset, int grid_offset)
         if (x_start + x_offset < 0) {
             x_start = -x_offset - 1;
         }
-        color_t *value = &data.cache.buffer[(y_offset + y) * data.cache.stride + x_start + x_offset + 1];
         for (int x = x_start; x < x_end - 1; x++) {
-            *value++ = ((x + y) & 1) ? colors->center.left : colors->center.right;
+            draw_pixel(x + x_offset + 1, y + y_offset, ((x + y) & 1) ? colors->center.left : colors->center.right);
         }
     }
 }
 
-static void draw_minimap_tile(int x_view, int y_view, int grid_offset)
+static void get_tile_appearance(int grid_offset, tile_appearance *tile)
 {
+    tile->grid_offset = grid_offset;
+    tile->type = TILE_APPEARANCE_NONE;
+    tile->size = 1;
+    tile->colors = 0;
+
     if (grid_offset < 0) {
         return;
     }
 
-    if (draw_figure(x_view, y_view, grid_offset)) {
+    if (get_figure_appearance(grid_offset, tile)) {
         return;
     }
     int terrain = data.functions->offset.terrain(grid_offset);
 
     if (terrain & TERRAIN_BUILDING) {
-        draw_building(x_view, y_view, grid_offset);
+        get_building_appearance(grid_offset, tile);
         return;
     }
     int rand = data.functions->offset.random(grid_offset);
@@ -462,7 +508,126 @@ static void draw_minimap_tile(int x_view, int y_view, int grid_offset)
     } else {
         colors = &minimap_colors.climate->grass[rand & 7];
     }
-    draw_tile(x_view, y_view, colors);
+    tile->type = TILE_APPEARANCE_TERRAIN;
+    tile->colors = colors;
+}
+
+static int is_same_appearance(const tile_appearance *a, const tile_appearance *b)
+{
+    return a->grid_offset == b->grid_offset && a->type == b->type && a->size == b->size && a->colors == b->colors;
+}
+
+static void draw_tile_appearance(int x_view, int y_view, const tile_appearance *tile)
+{
+    switch (tile->type) {
+        case TILE_APPEARANCE_FIGURE:
+            draw_pixel(x_view, y_view, *(const color_t *) tile->colors);
+            draw_pixel(x_view + 1, y_view, *(const color_t *) tile->colors);
+            break;
+        case TILE_APPEARANCE_TERRAIN:
+            draw_tile(x_view, y_view, tile->colors);
+            break;
+        case TILE_APPEARANCE_BUILDING:
+            draw_building(x_view, y_view, tile->colors, tile->size);
+            break;
+        default:
+            break;
+    }
+}
+
+static void get_tile_area(int x_view, int y_view, const tile_appearance *tile,
+    int *x_min, int *y_min, int *x_max, int *y_max)
+{
+    int size = tile->type == TILE_APPEARANCE_BUILDING ? tile->size : 1;
+    *x_min = x_view;
+    *x_max = x_view + size * 2 - 1;
+    *y_min = y_view - (size - 1);
+    *y_max = y_view + (size - 1);
+}
+
+static void mark_area_dirty(int x_min, int y_min, int x_max, int y_max)
+{
+    if (x_min < 0) {
+        x_min = 0;
+    }
+    if (x_max >= data.cache.stride) {
+        x_max = data.cache.stride - 1;
+    }
+    if (y_min < 0) {
+        y_min = 0;
+    }
+    if (y_max >= data.cache.height) {
+        y_max = data.cache.height - 1;
+    }
+    if (x_min > x_max || y_min > y_max) {
+        return;
+    }
+    for (int band = y_min / DIRTY_BAND_HEIGHT; band <= y_max / DIRTY_BAND_HEIGHT; band++) {
+        if (x_min < data.cache.bands[band].x_min) {
+            data.cache.bands[band].x_min = x_min;
+        }
+        if (x_max > data.cache.bands[band].x_max) {
+            data.cache.bands[band].x_max = x_max;
+        }
+    }
+}
+
+static int is_area_dirty(int x_min, int y_min, int x_max, int y_max)
+{
+    if (y_min < 0) {
+        y_min = 0;
+    }
+    if (y_max >= data.cache.height) {
+        y_max = data.cache.height - 1;
+    }
+    for (int band = y_min / DIRTY_BAND_HEIGHT; band <= y_max / DIRTY_BAND_HEIGHT && y_min <= y_max; band++) {
+        if (x_max >= data.cache.bands[band].x_min && x_min <= data.cache.bands[band].x_max) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void store_tile(int x_view, int y_view, int grid_offset)
+{
+    if (data.cache.num_tiles < data.cache.max_tiles) {
+        get_tile_appearance(grid_offset, &data.cache.tiles[data.cache.num_tiles++]);
+    }
+}
+
+static void find_changed_tile(int x_view, int y_view, int grid_offset)
+{
+    if (data.cache.num_tiles >= data.cache.max_tiles) {
+        return;
+    }
+    tile_appearance *tile = &data.cache.tiles[data.cache.num_tiles++];
+    tile_appearance current;
+    get_tile_appearance(grid_offset, &current);
+    if (is_same_appearance(tile, &current)) {
+        return;
+    }
+    int x_min, y_min, x_max, y_max;
+    get_tile_area(x_view, y_view, tile, &x_min, &y_min, &x_max, &y_max);
+    mark_area_dirty(x_min, y_min, x_max, y_max);
+    get_tile_area(x_view, y_view, &current, &x_min, &y_min, &x_max, &y_max);
+    mark_area_dirty(x_min, y_min, x_max, y_max);
+    *tile = current;
+}
+
+static void redraw_dirty_tile(int x_view, int y_view, int grid_offset)
+{
+    if (data.cache.num_tiles >= data.cache.max_tiles) {
+        return;
+    }
+    const tile_appearance *tile = &data.cache.tiles[data.cache.num_tiles++];
+    if (tile->type == TILE_APPEARANCE_NONE) {
+        return;
+    }
+    int x_min, y_min, x_max, y_max;
+    get_tile_area(x_view, y_view, tile, &x_min, &y_min, &x_max, &y_max);
+    if (is_area_dirty(x_min, y_min, x_max, y_max)) {
+        draw_tile_appearance(x_view, y_view, tile);
+    }
 }
 
 static void draw_viewport_rectangle(void)
@@ -483,23 +648,113 @@ static void draw_viewport_rectangle(void)
         COLOR_MINIMAP_VIEWPORT);
 }
 
+static void free_minimap_cache(void)
+{
+    free(data.cache.buffer);
+    free(data.cache.upload_buffer);
+    free(data.cache.tiles);
+    free(data.cache.bands);
+    data.cache.buffer = 0;
+    data.cache.upload_buffer = 0;
+    data.cache.tiles = 0;
+    data.cache.bands = 0;
+    data.cache.is_valid = 0;
+}
+
 static void prepare_minimap_cache(void)
 {
     if (data.functions->map.width() != data.minimap.width || data.functions->map.height() * 2 != data.minimap.height ||
-        !graphics_renderer()->has_custom_image(CUSTOM_IMAGE_MINIMAP)) {
+        !graphics_renderer()->has_custom_image(CUSTOM_IMAGE_MINIMAP) || !data.cache.buffer) {
         data.minimap.width = data.functions->map.width();
         data.minimap.height = data.functions->map.height() * 2;
         data.minimap.x = (VIEW_X_MAX - data.minimap.width) / 2;
         data.minimap.y = (VIEW_Y_MAX - data.minimap.height) / 2;
 
         graphics_renderer()->create_custom_image(CUSTOM_IMAGE_MINIMAP, data.minimap.width * 2, data.minimap.height, 0);
+
+        // The minimap is kept in its own buffer so that only the changed parts need to be redrawn and uploaded
+        free_minimap_cache();
+        data.cache.stride = data.minimap.width * 2;
+        data.cache.height = data.minimap.height;
+        data.cache.num_bands = (data.cache.height + DIRTY_BAND_HEIGHT - 1) / DIRTY_BAND_HEIGHT;
+        // Upper bound for the number of tiles visited by city_view_foreach_minimap_tile
+        data.cache.max_tiles = (data.minimap.width + 4) * (data.minimap.height + 8);
+        data.cache.buffer = malloc(sizeof(color_t) * data.cache.stride * data.cache.height);
+        data.cache.upload_buffer = malloc(sizeof(color_t) * data.cache.stride * DIRTY_BAND_HEIGHT);
+        data.cache.tiles = malloc(sizeof(tile_appearance) * data.cache.max_tiles);
+        data.cache.bands = malloc(sizeof(dirty_band) * data.cache.num_bands);
+        if (!data.cache.buffer || !data.cache.upload_buffer || !data.cache.tiles || !data.cache.bands) {
+            free_minimap_cache();
+        }
     }
-    data.cache.buffer = graphics_renderer()->get_custom_image_buffer(CUSTOM_IMAGE_MINIMAP, &data.cache.stride);
 }
 
-static void clear_minimap(void)
+static void set_all_bands(int dirty)
 {
-    memset(data.cache.buffer, 0, sizeof(color_t) * data.minimap.height * data.cache.stride);
+    for (int i = 0; i < data.cache.num_bands; i++) {
+        data.cache.bands[i].x_min = dirty ? 0 : data.cache.stride;
+        data.cache.bands[i].x_max = dirty ? data.cache.stride - 1 : -1;
+    }
+}
+
+static void clear_dirty_bands(void)
+{
+    for (int i = 0; i < data.cache.num_bands; i++) {
+        const dirty_band *band = &data.cache.bands[i];
+        if (band->x_min > band->x_max) {
+            continue;
+        }
+        int y_max = (i + 1) * DIRTY_BAND_HEIGHT;
+        if (y_max > data.cache.height) {
+            y_max = data.cache.height;
+        }
+        for (int y = i * DIRTY_BAND_HEIGHT; y < y_max; y++) {
+            memset(&data.cache.buffer[y * data.cache.stride + band->x_min], 0,
+                sizeof(color_t) * (band->x_max - band->x_min + 1));
+        }
+    }
+}
+
+static void upload_dirty_bands(void)
+{
+    for (int i = 0; i < data.cache.num_bands; i++) {
+        const dirty_band *band = &data.cache.bands[i];
+        if (band->x_min > band->x_max) {
+            continue;
+        }
+        int y_min = i * DIRTY_BAND_HEIGHT;
+        int height = data.cache.height - y_min < DIRTY_BAND_HEIGHT ? data.cache.height - y_min : DIRTY_BAND_HEIGHT;
+        int width = band->x_max - band->x_min + 1;
+        for (int y = 0; y < height; y++) {
+            memcpy(&data.cache.upload_buffer[y * width],
+                &data.cache.buffer[(y_min + y) * data.cache.stride + band->x_min], sizeof(color_t) * width);
+        }
+        graphics_renderer()->update_custom_image_from(CUSTOM_IMAGE_MINIMAP, data.cache.upload_buffer,
+            band->x_min, y_min, width, height);
+    }
+}
+
+static void redraw_minimap(void)
+{
+    set_all_bands(1);
+    clear_dirty_bands();
+    data.cache.num_tiles = 0;
+    foreach_map_tile(store_tile);
+    data.cache.num_tiles = 0;
+    foreach_map_tile(redraw_dirty_tile);
+    graphics_renderer()->update_custom_image_from(CUSTOM_IMAGE_MINIMAP, data.cache.buffer,
+        0, 0, data.cache.stride, data.cache.height);
+}
+
+static void redraw_changed_tiles(void)
+{
+    set_all_bands(0);
+    data.cache.num_tiles = 0;
+    foreach_map_tile(find_changed_tile);
+    clear_dirty_bands();
+    data.cache.num_tiles = 0;
+    foreach_map_tile(redraw_dirty_tile);
+    upload_dirty_bands();
 }
 
 void widget_minimap_update(const minimap_functions *functions)
@@ -509,10 +764,16 @@ void widget_minimap_update(const minimap_functions *functions)
     if (!data.cache.buffer) {
         return;
     }
-    clear_minimap();
-    minimap_colors.climate = &CLIMATE_VARIANTS[data.functions->climate()];
-    foreach_map_tile(draw_minimap_tile);
-    graphics_renderer()->update_custom_image(CUSTOM_IMAGE_MINIMAP);
+    const tile_color_climate_variants *climate = &CLIMATE_VARIANTS[data.functions->climate()];
+    int is_city_minimap = data.functions == &default_functions;
+    if (data.cache.is_valid && is_city_minimap && minimap_colors.climate == climate) {
+        redraw_changed_tiles();
+    } else {
+        minimap_colors.climate = climate;
+        redraw_minimap();
+        // Minimaps of other files share the image, so the city minimap is fully redrawn after them
+        data.cache.is_valid = is_city_minimap;
+    }
 }
 
 void widget_minimap_draw(int x_offset, int y_offset, int width, int height)
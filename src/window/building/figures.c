@@ -10,6 +10,7 @@
 #include "city/trade_policy.h"
 #include "city/view.h"
 #include "core/config.h"
+#include "core/lang.h"
 #include "empire/city.h"
 #include "figure/figure.h"
 #include "figure/formation.h"
@@ -48,14 +49,6 @@ static const int FIGURE_TYPE_TO_BIG_FIGURE_IMAGE[] = {
     3, 58, 50, 0, 0, 3, 15, 15, 0, 51, //80-89
     0, 0, 0, 17, 0, 0, 0, 0, 0, 0, 0, //90-99
 };
-// Starting with FIGURE_WORK_CAMP_WORKER = 73,
-static const int NEW_FIGURE_TYPES[] = {
-    TR_FIGURE_TYPE_WORK_CAMP_WORKER,TR_FIGURE_TYPE_WORK_CAMP_SLAVE,TR_FIGURE_TYPE_WORK_CAMP_ARCHITECT,TR_FIGURE_TYPE_MESS_HALL_SUPPLIER,TR_FIGURE_TYPE_MESS_HALL_COLLECTOR,
-    TR_FIGURE_TYPE_PRIEST_SUPPLIER, TR_FIGURE_TYPE_BARKEEP, TR_FIGURE_TYPE_BARKEEP_SUPPLIER, TR_FIGURE_TYPE_TOURIST, TR_FIGURE_TYPE_WATCHMAN, 0, 0, TR_FIGURE_TYPE_CARAVANSERAI_SUPPLIER,
-    TR_FIGURE_TYPE_ROBBER, TR_FIGURE_TYPE_LOOTER, TR_FIGURE_TYPE_CARAVANSERAI_COLLECTOR, TR_FIGURE_TYPE_LIGHTHOUSE_SUPPLIER, TR_FIGURE_TYPE_MESS_HALL_COLLECTOR, 0, 0, TR_FIGURE_TYPE_BEGGAR,
-    0, FIGURE_ENEMY_CATAPULT, 0
-};
-
 static generic_button figure_buttons[] = {
     {26, 46, 50, 50, select_figure},
     {86, 46, 50, 50, select_figure, 0, 1},
@@ -127,7 +120,7 @@ static figure *get_head_of_caravan(figure *f)
 static void draw_trader(building_info_context *c, figure *f)
 {
     f = get_head_of_caravan(f);
-    const empire_city *city = empire_city_get(f->empire_city_id);
+    const empire_city *city = empire_city_get(figure_extra_get(f->id)->empire_city_id);
     int width = lang_text_draw(64, f->type, c->x_offset + 40, c->y_offset + 110, FONT_NORMAL_BROWN);
     const uint8_t *city_name = empire_city_get_name(city);
     text_draw(city_name, c->x_offset + 40 + width, c->y_offset + 110, FONT_NORMAL_BROWN, 0);
@@ -136,7 +129,7 @@ static void draw_trader(building_info_context *c, figure *f)
     width = lang_text_draw(129, 1, c->x_offset + 40, c->y_offset + 130, FONT_NORMAL_BROWN);
     lang_text_draw_amount(8, 10, f->type == FIGURE_TRADE_SHIP ? figure_trade_sea_trade_units() : figure_trade_land_trade_units(), c->x_offset + 40 + width, c->y_offset + 130, FONT_NORMAL_BROWN);
 
-    int trader_id = f->trader_id;
+    int trader_id = figure_extra_get(f->id)->trader_id;
     if (f->type == FIGURE_TRADE_SHIP) {
         int text_id;
         switch (f->action_state) {
@@ -457,8 +450,7 @@ static void draw_supplier(building_info_context *c, figure *f)
     if (f->type == FIGURE_MESS_HALL_SUPPLIER || f->type == FIGURE_PRIEST_SUPPLIER ||
         f->type == FIGURE_BARKEEP_SUPPLIER || f->type == FIGURE_CARAVANSERAI_SUPPLIER ||
         f->type == FIGURE_LIGHTHOUSE_SUPPLIER) {
-        int relative_id = f->type - FIGURE_NEW_TYPES;
-        width = text_draw(translation_for(NEW_FIGURE_TYPES[relative_id]), c->x_offset + 92, c->y_offset + 139, FONT_NORMAL_BROWN, 0);
+        width = text_draw(lang_get_figure_type_string(f->type), c->x_offset + 92, c->y_offset + 139, FONT_NORMAL_BROWN, 0);
     } else {
         width = lang_text_draw(64, f->type, c->x_offset + 92, c->y_offset + 139, FONT_NORMAL_BROWN);
     }
@@ -487,8 +479,7 @@ static void draw_monument_worker(building_info_context *c, figure *f)
     image_draw(big_people_image(f->type), c->x_offset + 28, c->y_offset + 112, COLOR_MASK_NONE, SCALE_NONE);
 
     lang_text_draw(65, f->name, c->x_offset + 90, c->y_offset + 108, FONT_LARGE_BROWN);
-    int relative_id = f->type - FIGURE_NEW_TYPES;
-    int width = text_draw(translation_for(NEW_FIGURE_TYPES[relative_id]), c->x_offset + 92, c->y_offset + 139, FONT_NORMAL_BROWN, 0);
+    int width = text_draw(lang_get_figure_type_string(f->type), c->x_offset + 92, c->y_offset + 139, FONT_NORMAL_BROWN, 0);
     int resource = f->collecting_item_id;
 
     if (f->action_state == FIGURE_ACTION_204_WORK_CAMP_WORKER_GETTING_RESOURCES) {
@@ -520,12 +511,7 @@ static void draw_normal_figure(building_info_context *c, figure *f)
     image_draw(image_id, c->x_offset + 28, c->y_offset + 112, COLOR_MASK_NONE, SCALE_NONE);
 
     lang_text_draw(65, f->name, c->x_offset + 90, c->y_offset + 108, FONT_LARGE_BROWN);
-    if (f->type >= FIGURE_NEW_TYPES && f->type < FIGURE_TYPE_MAX) {
-        int relative_id = f->type - FIGURE_NEW_TYPES;
-        text_draw(translation_for(NEW_FIGURE_TYPES[relative_id]), c->x_offset + 92, c->y_offset + 139, FONT_NORMAL_BROWN, 0);
-    } else {
-        lang_text_draw(64, f->type, c->x_offset + 92, c->y_offset + 139, FONT_NORMAL_BROWN);
-    }
+    text_draw(lang_get_figure_type_string(f->type), c->x_offset + 92, c->y_offset + 139, FONT_NORMAL_BROWN, 0);
 
     if (c->figure.phrase_id >= 0) {
         lang_text_draw_multiline(130, 21 * c->figure.sound_id + c->figure.phrase_id + 1,
@@ -536,9 +522,10 @@ static void draw_normal_figure(building_info_context *c, figure *f)
         lang_text_draw_multiline(130, 21 * c->figure.sound_id + c->figure.phrase_id + 1,
             c->x_offset + 90, c->y_offset + 160, 16 * (c->width_blocks - 8), FONT_NORMAL_BROWN);
     }
-    if (f->tourist.tourist_money_spent) {
+    const figure_extra *extra = figure_extra_get(f->id);
+    if (extra->tourist.tourist_money_spent) {
         int width = text_draw(translation_for(TR_WINDOW_FIGURE_TOURIST), c->x_offset + 92, c->y_offset + 180, FONT_NORMAL_BROWN, 0);
-        text_draw_money(f->tourist.tourist_money_spent, c->x_offset + 92 + width, c->y_offset + 180, FONT_NORMAL_BROWN);
+        text_draw_money(extra->tourist.tourist_money_spent, c->x_offset + 92 + width, c->y_offset + 180, FONT_NORMAL_BROWN);
     }
 }
 
@@ -647,7 +634,7 @@ void window_building_play_figure_phrase(building_info_context *c)
     int figure_id = c->figure.figure_ids[c->figure.selected_index];
     figure *f = figure_get(figure_id);
     c->figure.sound_id = figure_phrase_play(f);
-    c->figure.phrase_id = f->phrase_id;
+    c->figure.phrase_id = figure_extra_get(f->id)->phrase_id;
 }
 
 static void depot_recall(const generic_button *button)
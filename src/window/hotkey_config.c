@@ -56,6 +56,8 @@ static hotkey_widget hotkey_widgets[] = {
     {HOTKEY_SAVE_SCREENSHOT, TR_HOTKEY_SAVE_SCREENSHOT},
     {HOTKEY_SAVE_CITY_SCREENSHOT, TR_HOTKEY_SAVE_CITY_SCREENSHOT},
     {HOTKEY_SAVE_MINIMAP_SCREENSHOT, TR_HOTKEY_SAVE_MINIMAP_SCREENSHOT},
+    {HOTKEY_TOGGLE_TICK_PROFILER, TR_HOTKEY_TOGGLE_TICK_PROFILER},
+    {HOTKEY_SAVE_TICK_PROFILE, TR_HOTKEY_SAVE_TICK_PROFILE},
     {HOTKEY_LOAD_FILE, TR_HOTKEY_LOAD_FILE},
     {HOTKEY_SAVE_FILE, TR_HOTKEY_SAVE_FILE},
     {HOTKEY_HEADER, TR_HOTKEY_HEADER_CITY},